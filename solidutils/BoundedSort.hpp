@@ -0,0 +1,115 @@
+/**
+* @file BoundedSort.hpp
+* @brief The BoundedSort class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-05-18
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef SOLIDUTILS_INCLUDE_BOUNDEDSORT_HPP
+#define SOLIDUTILS_INCLUDE_BOUNDEDSORT_HPP
+
+
+#include "VectorMath.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace sl
+{
+
+
+/**
+* @brief The BoundedSort class contains a serial sort for integer keys known
+* to lie within a range, for use by the basic containers without pulling in
+* the parallel and vectorized sorts of the Sort class.
+*/
+class BoundedSort
+{
+  public:
+    /**
+    * @brief Sort a set of keys in place, where the keys are known to be in
+    * the range [0,max). This uses an LSD radix sort with 8-bit digits,
+    * performing only as many passes as there are digits in max, and so runs
+    * in O(num log(max) / 8) time.
+    *
+    * @tparam K The key type (must be integral).
+    * @param keys The keys to sort.
+    * @param num The number of keys.
+    * @param max The upper bound on the keys (exclusive).
+    * @param scratch Scratch memory of at least num elements.
+    */
+    template<typename K>
+    static void radix(
+        K * const keys,
+        size_t const num,
+        size_t const max,
+        K * const scratch) noexcept
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+
+      constexpr size_t const BITS = 8;
+      constexpr size_t const RADIX = static_cast<size_t>(1) << BITS;
+
+      if (max <= 1) {
+        // all keys are zero
+        return;
+      }
+
+      size_t const maxKey = max - 1;
+
+      K * in = keys;
+      K * out = scratch;
+
+      size_t counts[RADIX];
+      for (size_t shift = 0; shift < sizeof(size_t)*8 && \
+          (maxKey >> shift) != 0; shift += BITS) {
+        std::fill(counts, counts+RADIX, 0);
+        for (size_t i = 0; i < num; ++i) {
+          ++counts[(static_cast<size_t>(in[i]) >> shift) & (RADIX-1)];
+        }
+
+        VectorMath::prefixSumExclusive(counts, RADIX);
+
+        for (size_t i = 0; i < num; ++i) {
+          K const key = in[i];
+          out[counts[(static_cast<size_t>(key) >> shift) & (RADIX-1)]++] = \
+              key;
+        }
+
+        std::swap(in, out);
+      }
+
+      if (in != keys) {
+        std::copy(in, in+num, keys);
+      }
+    }
+};
+
+
+}
+
+
+#endif
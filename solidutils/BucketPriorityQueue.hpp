@@ -0,0 +1,556 @@
+/**
+ * @file BucketPriorityQueue.hpp
+ * @brief The BucketPriorityQueue class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-04-06
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_BUCKETPRIORITYQUEUE_HPP
+#define SOLIDUTILS_INCLUDE_BUCKETPRIORITYQUEUE_HPP
+
+#include "Array.hpp"
+
+#include <type_traits>
+
+namespace sl
+{
+
+
+/**
+* @brief The order in which values with the same key leave a
+* BucketPriorityQueue.
+*/
+enum class TieBreaking
+{
+  /**
+  * @brief The most recently inserted value is popped first.
+  */
+  LIFO,
+  /**
+  * @brief The least recently inserted value is popped first.
+  */
+  FIFO
+};
+
+
+/**
+* @brief The BucketPriorityQueue class provides a max priority queue for
+* integer keys within a bounded range, as used in Fiduccia-Mattheyses
+* refinement. Each key has a bucket holding a doubly linked list of values,
+* and the highest non-empty bucket is tracked. Insertion and queries are
+* O(1). Deletion, update, and pop are O(1) plus a downward scan from the
+* highest bucket to the next non-empty one when the highest bucket empties,
+* which is bounded by the range of keys. As in classic FM, where a move
+* changes the gains of its neighbors by bounded deltas, the scans are short
+* in practice, but alternately adding and removing a value at the maximum
+* key while the only other value is at the minimum key costs
+* O(maxKey - minKey) per removal.
+*
+* It provides the add(), remove(), update(), updateByDelta(), contains(),
+* get(), pop(), peek(), max(), size(), clear(), and remaining() operations of
+* FixedPriorityQueue with the same signatures, so that the two can be
+* swapped via a template parameter where only those are used. It is always
+* a max queue, and has no equivalent of build(), drain(), or the deferred
+* updates.
+*
+* @tparam K The key type (must be integral).
+* @tparam V The value type (must be integral).
+* @tparam ORDER The tie breaking order for values with the same key.
+*/
+template<typename K, typename V, TieBreaking ORDER = TieBreaking::LIFO>
+class BucketPriorityQueue
+{
+  public:
+    static_assert(std::is_integral<K>::value, "Must by integral type.");
+    static_assert(std::is_integral<V>::value, "Must by integral type.");
+
+    static constexpr V const NULL_VALUE = static_cast<V>(-1);
+
+    class ValueSet
+    {
+      public:
+      class Iterator
+      {
+        public:
+        /**
+        * @brief Create a new forward iterator.
+        *
+        * @param bucket The bucket of the iterator.
+        * @param value The value of the iterator (NULL_VALUE for the end).
+        * @param q The priority queue being iterated.
+        */
+        Iterator(
+            size_t const bucket,
+            V const value,
+            BucketPriorityQueue<K,V,ORDER> const * const q) :
+          m_bucket(bucket),
+          m_value(value),
+          m_q(q)
+        {
+          // do nothing
+        }
+
+        /**
+        * @brief Get the value of the iterator.
+        *
+        * @return The value.
+        */
+        inline V operator*() const noexcept
+        {
+          return m_value;
+        }
+
+        /**
+        * @brief Move the iterator forward, to the next value in the bucket,
+        * or the first value of the next non-empty bucket below it.
+        *
+        * @return This iterator.
+        */
+        inline Iterator & operator++()
+        {
+          m_value = m_q->m_next[m_value];
+          while (m_value == NULL_VALUE && m_bucket > 0) {
+            --m_bucket;
+            m_value = m_q->m_heads[m_bucket];
+          }
+
+          return *this;
+        }
+
+        /**
+        * @brief Check if this iterator is the same as another.
+        *
+        * @param other The other iterator.
+        *
+        * @return True if they are at the same position.
+        */
+        inline bool operator==(
+            Iterator const & other) const
+        {
+          return m_value == other.m_value;
+        }
+
+        /**
+        * @brief Check if this iterator is different from another iterator.
+        *
+        * @param other The other iterator.
+        *
+        * @return True if the iterators are not equal.
+        */
+        inline bool operator!=(
+            Iterator const & other) const
+        {
+          return !(*this == other);
+        }
+
+        private:
+        size_t m_bucket;
+        V m_value;
+        BucketPriorityQueue<K,V,ORDER> const * m_q;
+      };
+
+      /**
+      * @brief Create a new value set.
+      *
+      * @param q The priority queue.
+      */
+      ValueSet(
+          BucketPriorityQueue<K,V,ORDER> const * const q) :
+        m_q(q)
+      {
+        // do nothing
+      }
+
+      /**
+      * @brief Get the forward iterator to the start of the set.
+      *
+      * @return The forward iterator.
+      */
+      inline Iterator begin() const noexcept
+      {
+        if (m_q->m_size == 0) {
+          return end();
+        }
+
+        return Iterator(m_q->m_top, m_q->m_heads[m_q->m_top], m_q);
+      }
+
+      /**
+      * @brief Get the forward iterator to the end of the set.
+      *
+      * @return The end iterator.
+      */
+      inline Iterator end() const noexcept
+      {
+        return Iterator(0, NULL_VALUE, m_q);
+      }
+
+      private:
+      BucketPriorityQueue<K,V,ORDER> const * m_q;
+    };
+
+    /**
+    * @brief Create a new priority queue that can hold elements 0 through max
+    * with keys in the range [minKey, maxKey].
+    *
+    * @param minKey The minimum key (inclusive).
+    * @param maxKey The maximum key (inclusive).
+    * @param max The max value in the priority queue (exclusive).
+    */
+    BucketPriorityQueue(
+        K const minKey,
+        K const maxKey,
+        V const max) :
+      m_minKey(minKey),
+      m_heads(static_cast<size_t>(maxKey - minKey) + 1, NULL_VALUE),
+      m_tails(ORDER == TieBreaking::FIFO ? m_heads.size() : 0, NULL_VALUE),
+      m_next(max),
+      m_prev(max),
+      m_keys(max),
+      m_present(max, false),
+      m_top(0),
+      m_size(0)
+    {
+      ASSERT_LESSEQUAL(minKey, maxKey);
+    }
+
+
+    /**
+    * @brief Remove an element from the queue.
+    *
+    * @param value The element to remove
+    */
+    void remove(
+        V const value) noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      unlink(value, bucketOf(m_keys[value]));
+      m_present[value] = false;
+      --m_size;
+
+      if (m_size == 0) {
+        m_top = 0;
+      } else {
+        while (m_heads[m_top] == NULL_VALUE) {
+          --m_top;
+        }
+      }
+    }
+
+
+    /**
+    * @brief Add an value to the queue.
+    *
+    * @param key The key/priority of the value to add.
+    * @param value The value to add.
+    */
+    void add(
+        K const key,
+        V const value) noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_present.size());
+      ASSERT_FALSE(m_present[value]);
+
+      size_t const bucket = bucketOf(key);
+
+      m_keys[value] = key;
+      m_present[value] = true;
+      link(value, bucket);
+      ++m_size;
+
+      if (bucket > m_top) {
+        m_top = bucket;
+      }
+    }
+
+
+    /**
+    * @brief Update the key associated with a given value. If the key is
+    * unchanged, the value retains its position among values of the same key.
+    *
+    * @param key The new key for the value.
+    * @param value The value.
+    */
+    void update(
+        K const key,
+        V const value) noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      K const oldKey = m_keys[value];
+      if (key != oldKey) {
+        size_t const bucket = bucketOf(key);
+
+        unlink(value, bucketOf(oldKey));
+        m_keys[value] = key;
+        link(value, bucket);
+
+        if (bucket > m_top) {
+          m_top = bucket;
+        } else {
+          while (m_heads[m_top] == NULL_VALUE) {
+            --m_top;
+          }
+        }
+      }
+    }
+
+
+    /**
+    * @brief Update the key associated with a given value by modifying the key.
+    *
+    * @param delta The change in priority.
+    * @param value The value.
+    */
+    void updateByDelta(
+        K const delta,
+        V const value) noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      update(m_keys[value] + delta, value);
+    }
+
+
+    /**
+    * @brief Check if a value in present in the priority queue.
+    *
+    * @param value The value to check for.
+    *
+    * @return Whether or not the value is present.
+    */
+    bool contains(
+        V const value) const noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_present.size());
+
+      return m_present[value];
+    }
+
+
+    /**
+    * @brief Get the key associated with the given value.
+    *
+    * @param value The value.
+    *
+    * @return The key.
+    */
+    K get(
+        V const value) const noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      return m_keys[value];
+    }
+
+
+    /**
+    * @brief Pop the top value from the queue.
+    *
+    * @return The top value.
+    */
+    V pop() noexcept
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      V const value = m_heads[m_top];
+      remove(value);
+
+      return value;
+    }
+
+
+    /**
+    * @brief Get get the top of the priority queue's value.
+    *
+    * @return The value.
+    */
+    V const & peek() const noexcept
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      return m_heads[m_top];
+    }
+
+
+    /**
+    * @brief Get get the top of the priority queue's key.
+    *
+    * @return The key.
+    */
+    K const & max() const noexcept
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      return m_keys[m_heads[m_top]];
+    }
+
+
+    /**
+    * @brief Get the number of elements in the queue.
+    *
+    * @return The number of elements.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Clear entries from the priority queue. This is O(size + the
+    * range of keys below the current maximum).
+    */
+    void clear() noexcept
+    {
+      for (size_t bucket = 0; m_size > 0; ++bucket) {
+        V value = m_heads[bucket];
+        while (value != NULL_VALUE) {
+          m_present[value] = false;
+          --m_size;
+          value = m_next[value];
+        }
+        m_heads[bucket] = NULL_VALUE;
+        if (ORDER == TieBreaking::FIFO) {
+          m_tails[bucket] = NULL_VALUE;
+        }
+      }
+      m_top = 0;
+    }
+
+
+    /**
+    * @brief Get the set of remaining items in the priority queue. The values
+    * are visited from the highest key down, in the order of each bucket's
+    * list. Iterating over the set takes O(size() + the range of keys below
+    * the current maximum) time, and the queue must not be modified while
+    * doing so.
+    *
+    * @return The set of values.
+    */
+    ValueSet remaining() const noexcept
+    {
+      return ValueSet(this);
+    }
+
+
+  private:
+    K m_minKey;
+    Array<V> m_heads;
+    Array<V> m_tails;
+    Array<V> m_next;
+    Array<V> m_prev;
+    Array<K> m_keys;
+    Array<bool> m_present;
+    size_t m_top;
+    size_t m_size;
+
+
+    /**
+    * @brief Get the bucket for a given key.
+    *
+    * @param key The key.
+    *
+    * @return The bucket index.
+    */
+    size_t bucketOf(
+        K const key) const noexcept
+    {
+      ASSERT_GREATEREQUAL(key, m_minKey);
+
+      size_t const bucket = static_cast<size_t>(key - m_minKey);
+
+      ASSERT_LESS(bucket, m_heads.size());
+
+      return bucket;
+    }
+
+
+    /**
+    * @brief Insert a value into a bucket's list. For LIFO ordering it is
+    * placed at the head, and for FIFO ordering at the tail.
+    *
+    * @param value The value.
+    * @param bucket The bucket.
+    */
+    void link(
+        V const value,
+        size_t const bucket) noexcept
+    {
+      if (ORDER == TieBreaking::FIFO) {
+        V const tail = m_tails[bucket];
+        m_prev[value] = tail;
+        m_next[value] = NULL_VALUE;
+        if (tail == NULL_VALUE) {
+          m_heads[bucket] = value;
+        } else {
+          m_next[tail] = value;
+        }
+        m_tails[bucket] = value;
+      } else {
+        V const head = m_heads[bucket];
+        m_prev[value] = NULL_VALUE;
+        m_next[value] = head;
+        if (head != NULL_VALUE) {
+          m_prev[head] = value;
+        }
+        m_heads[bucket] = value;
+      }
+    }
+
+
+    /**
+    * @brief Remove a value from a bucket's list.
+    *
+    * @param value The value.
+    * @param bucket The bucket.
+    */
+    void unlink(
+        V const value,
+        size_t const bucket) noexcept
+    {
+      V const prev = m_prev[value];
+      V const next = m_next[value];
+
+      if (prev == NULL_VALUE) {
+        m_heads[bucket] = next;
+      } else {
+        m_next[prev] = next;
+      }
+
+      if (next != NULL_VALUE) {
+        m_prev[next] = prev;
+      } else if (ORDER == TieBreaking::FIFO) {
+        m_tails[bucket] = prev;
+      }
+    }
+};
+
+
+}
+
+#endif
@@ -31,7 +31,11 @@
 
 
 #include "Array.hpp"
+#include "BoundedSort.hpp"
 #include "ConstArray.hpp"
+#include "Prefetch.hpp"
+
+#include <algorithm>
 
 namespace sl
 {
@@ -127,6 +131,140 @@ class FixedMap
     }
 
 
+    /**
+    * @brief Add a value to the value associated with a key. If the key is not
+    * present, it is added with the given value.
+    *
+    * @param key The key.
+    * @param value The value to add.
+    */
+    void accumulate(
+        K const key,
+        V const value) noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, m_index.size());
+
+      if (m_index[index] == NULL_INDEX) {
+        add(key, value);
+      } else {
+        m_values[static_cast<size_t>(m_index[index])] += value;
+      }
+    }
+
+
+    /**
+    * @brief Check if a batch of keys exist in this map. Lookups are software
+    * pipelined, prefetching the index entries of keys ahead of the current
+    * one so that the cache misses of independent keys overlap.
+    *
+    * @param keys The keys to check for.
+    * @param num The number of keys.
+    * @param out The output array of whether each key is in the map (must be
+    * of length num).
+    */
+    void hasMany(
+        K const * const keys,
+        size_t const num,
+        bool * const out) const noexcept
+    {
+      constexpr size_t const dist = Prefetch::DISTANCE;
+
+      for (size_t i = 0; i < num; ++i) {
+        if (i + dist < num) {
+          Prefetch::read(m_index.data() + static_cast<size_t>(keys[i+dist]));
+        }
+        out[i] = has(keys[i]);
+      }
+    }
+
+
+    /**
+    * @brief Get the values associated with a batch of keys. All keys must be
+    * present in the map. The keys are processed in groups of
+    * Prefetch::DISTANCE in a three stage pipeline: the index entries of one
+    * group are prefetched, while those of the previous group, which have
+    * arrived, are read and their value slots prefetched, while the values of
+    * the group before that are written out. Both levels of indirection are
+    * thereby overlapped across keys.
+    *
+    * @param keys The keys.
+    * @param num The number of keys.
+    * @param out The output array of values (must be of length num).
+    */
+    void getMany(
+        K const * const keys,
+        size_t const num,
+        V * const out) const noexcept
+    {
+      constexpr size_t const GROUP = Prefetch::DISTANCE;
+
+      // the places of the two groups in flight
+      size_t places[2][GROUP];
+
+      size_t const numGroups = (num + GROUP - 1) / GROUP;
+      for (size_t g = 0; g < numGroups + 2; ++g) {
+        if (g < numGroups) {
+          size_t const end = std::min((g+1)*GROUP, num);
+          for (size_t i = g*GROUP; i < end; ++i) {
+            Prefetch::read(m_index.data() + static_cast<size_t>(keys[i]));
+          }
+        }
+
+        if (g >= 1 && g <= numGroups) {
+          size_t * const groupPlaces = places[(g-1) % 2];
+          size_t const start = (g-1)*GROUP;
+          size_t const end = std::min(g*GROUP, num);
+          for (size_t i = start; i < end; ++i) {
+            size_t const index = static_cast<size_t>(keys[i]);
+            ASSERT_LESS(index, m_index.size());
+
+            size_t const place = static_cast<size_t>(m_index[index]);
+            ASSERT_LESS(place, m_size);
+            groupPlaces[i - start] = place;
+            Prefetch::read(m_values.data() + place);
+          }
+        }
+
+        if (g >= 2) {
+          size_t const * const groupPlaces = places[g % 2];
+          size_t const start = (g-2)*GROUP;
+          size_t const end = std::min((g-1)*GROUP, num);
+          for (size_t i = start; i < end; ++i) {
+            out[i] = m_values[groupPlaces[i - start]];
+          }
+        }
+      }
+    }
+
+
+    /**
+    * @brief Add a batch of key-value pairs to this map. None of the keys may
+    * already be present, and the keys must be unique.
+    *
+    * @param keys The keys.
+    * @param values The values.
+    * @param num The number of key-value pairs.
+    */
+    void addMany(
+        K const * const keys,
+        V const * const values,
+        size_t const num) noexcept
+    {
+      constexpr size_t const dist = Prefetch::DISTANCE;
+
+      ASSERT_LESSEQUAL(m_size + num, m_keys.size());
+
+      for (size_t i = 0; i < num; ++i) {
+        if (i + dist < num) {
+          Prefetch::write(m_index.data() + static_cast<size_t>(keys[i+dist]));
+        }
+        add(keys[i], values[i]);
+      }
+    }
+
+
     /**
     * @brief Remove an key-value pair from this set.
     *
@@ -196,11 +334,81 @@ class FixedMap
     }
 
 
+    /**
+    * @brief Get a copy of the keys in this map in ascending order. This does
+    * not modify the map.
+    *
+    * @return The sorted keys.
+    */
+    Array<K> sortedKeys() const
+    {
+      Array<K> keys(m_size);
+      writeSorted(keys.data());
+
+      return keys;
+    }
+
+
+    /**
+    * @brief Re-order the key-value pairs in this map such that `keys()` and
+    * `values()` are in ascending order of key. The order is maintained until
+    * the next call to `remove()`.
+    */
+    void sortInPlace()
+    {
+      Array<V> oldValues(m_size);
+      std::copy(m_values.data(), m_values.data()+m_size, oldValues.data());
+
+      writeSorted(m_keys.data());
+
+      for (size_t i = 0; i < m_size; ++i) {
+        size_t const index = static_cast<size_t>(m_keys[i]);
+        size_t const place = static_cast<size_t>(m_index[index]);
+        m_values[i] = oldValues[place];
+        m_index[index] = i;
+      }
+    }
+
+
   private:
+    /**
+    * @brief When the map holds at least 1/DENSE_SORT_RATIO of the possible
+    * keys, sorting is done by scanning the index rather than via radix sort.
+    */
+    static constexpr size_t const DENSE_SORT_RATIO = 16;
+
     size_t m_size;
     Array<K> m_keys;
     Array<V> m_values;
     Array<K> m_index;
+
+
+    /**
+    * @brief Write the keys of the map in ascending order. The index is not
+    * modified.
+    *
+    * @param out The location to write the keys to (may be the map's own
+    * keys).
+    */
+    void writeSorted(
+        K * const out) const
+    {
+      if (m_size * DENSE_SORT_RATIO >= m_index.size()) {
+        // the index is already a histogram over the universe
+        size_t j = 0;
+        for (size_t k = 0; j < m_size; ++k) {
+          if (m_index[k] != NULL_INDEX) {
+            out[j++] = static_cast<K>(k);
+          }
+        }
+      } else {
+        if (out != m_keys.data()) {
+          std::copy(m_keys.data(), m_keys.data()+m_size, out);
+        }
+        Array<K> scratch(m_size);
+        BoundedSort::radix(out, m_size, m_index.size(), scratch.data());
+      }
+    }
 };
 
 }
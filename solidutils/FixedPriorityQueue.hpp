@@ -32,6 +32,12 @@
 #define SOLIDUTILS_INCLUDE_FIXEDPRIORITYQUEUE_HPP
 
 #include "Array.hpp"
+#include "Prefetch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 namespace sl
 {
@@ -42,15 +48,43 @@ namespace sl
 * with the standard O(log n) insertion, deletion, pop, and update operations,
 * but in addition can perform non-modifying queries in O(1) time.
 *
+* The heap is D-ary, with its keys and values stored in separate arrays, so
+* that comparisons only touch keys. The keys are laid out such that the D
+* children of a node are contiguous and start on a multiple of D elements
+* from a cache line aligned base. When D times the size of a key is a power
+* of two no larger than a cache line, each sift down step then compares keys
+* within a single cache line. Larger values of D make the heap shallower, at
+* the cost of more comparisons per level.
+*
+* The ordering follows the convention of std::priority_queue: with the
+* default comparator of std::less the largest key is at the top, and with
+* std::greater the smallest key is at the top.
+*
 * @tparam K The key type.
 * @tparam V The value type.
+* @tparam D The arity of the heap (the number of children per node).
+* @tparam C The comparator type, where `C()(a, b)` returns true if a belongs
+* below b in the queue.
 */
-template<typename K, typename V>
+template<typename K, typename V, size_t D = 4, typename C = std::less<K>>
 class FixedPriorityQueue
 {
   public:
+    static_assert(D >= 2, "The heap must have an arity of at least two.");
+
     static constexpr size_t const NULL_INDEX = static_cast<size_t>(-1);
 
+    /**
+    * @brief The alignment in bytes of the heap storage.
+    */
+    static constexpr size_t const CACHE_LINE_SIZE = 64;
+
+    /**
+    * @brief When at least 1/REBUILD_RATIO of the heap has deferred updates,
+    * `flush()` rebuilds the entire heap rather than sifting each value.
+    */
+    static constexpr size_t const REBUILD_RATIO = 8;
+
     class ValueSet
     {
       public:
@@ -65,7 +99,7 @@ class FixedPriorityQueue
         */
         Iterator(
             size_t const index,
-            FixedPriorityQueue<K,V> const * const q) :
+            FixedPriorityQueue<K,V,D,C> const * const q) :
           m_index(index),
           m_q(q)
         {
@@ -79,8 +113,7 @@ class FixedPriorityQueue
         */
         inline V operator*() const noexcept
         {
-          size_t const pos = m_q->m_index[m_index];
-          return m_q->m_data[pos].value;
+          return m_q->m_values[m_index];
         }
 
         /**
@@ -90,10 +123,7 @@ class FixedPriorityQueue
         */
         inline Iterator & operator++()
         {
-          do {
-            ++m_index;
-          } while (m_index < m_q->m_index.size() && \
-              m_q->m_index[m_index] == NULL_INDEX);
+          ++m_index;
 
           return *this;
         }
@@ -126,7 +156,7 @@ class FixedPriorityQueue
 
         private:
         size_t m_index;
-        FixedPriorityQueue<K,V> const * m_q;
+        FixedPriorityQueue<K,V,D,C> const * m_q;
       };
 
       /**
@@ -135,7 +165,7 @@ class FixedPriorityQueue
       * @param q The priority queue.
       */
       ValueSet(
-          FixedPriorityQueue<K,V> const * const q) :
+          FixedPriorityQueue<K,V,D,C> const * const q) :
         m_q(q)
       {
         // do nothing
@@ -148,14 +178,7 @@ class FixedPriorityQueue
       */
       inline Iterator begin() const noexcept
       {
-        // find first valid index
-        size_t index = 0;
-        while (index < m_q->m_index.size() && \
-            m_q->m_index[index] == NULL_INDEX) {
-          ++index;
-        }
-
-        return Iterator(index, m_q);
+        return Iterator(0, m_q);
       }
 
       /**
@@ -165,28 +188,78 @@ class FixedPriorityQueue
       */
       inline Iterator end() const noexcept
       {
-        return Iterator(m_q->m_index.size(), m_q);
+        return Iterator(m_q->m_size, m_q);
       }
 
       private:
-      FixedPriorityQueue<K,V> const * m_q;
+      FixedPriorityQueue<K,V,D,C> const * m_q;
     };
 
     /**
     * @brief Create a new priority queue that can hold element 0 through max.
     *
     * @param max The max value in the priority queue (exclusive).
+    * @param compare The comparator to order keys with.
     */
     FixedPriorityQueue(
-        V const max) :
-      m_data(max),
+        V const max,
+        C const & compare = C()) :
+      m_keyStorage(static_cast<size_t>(max) + D - 1 + \
+          (CACHE_LINE_SIZE / sizeof(K))),
+      m_keys(m_keyStorage.data() + rootOffset(m_keyStorage.data())),
+      m_values(max),
       m_index(max, NULL_INDEX),
-      m_size(0)
+      m_size(0),
+      m_compare(compare),
+      m_deferred(max, false),
+      m_dirty(),
+      m_order()
     {
       // do nothing
     }
 
 
+    /**
+    * @brief Deleted copy constructor.
+    *
+    * @param rhs The queue to copy.
+    */
+    FixedPriorityQueue(
+        FixedPriorityQueue const & rhs) = delete;
+
+
+    /**
+    * @brief Move constructor. The key storage is moved, so the location of
+    * the root's key remains valid.
+    *
+    * @param rhs The queue to move.
+    */
+    FixedPriorityQueue(
+        FixedPriorityQueue && rhs) = default;
+
+
+    /**
+    * @brief Deleted copy assignment operator.
+    *
+    * @param rhs The queue to copy.
+    *
+    * @return This queue.
+    */
+    FixedPriorityQueue & operator=(
+        FixedPriorityQueue const & rhs) = delete;
+
+
+    /**
+    * @brief Move assignment operator.
+    *
+    * @param rhs The queue to move.
+    *
+    * @return This queue.
+    */
+    FixedPriorityQueue & operator=(
+        FixedPriorityQueue && rhs) = default;
+
+
     /**
     * @brief Remove an element from the queue.
     *
@@ -195,6 +268,7 @@ class FixedPriorityQueue
     void remove(
         V const value) noexcept
     {
+      ASSERT_TRUE(m_dirty.empty());
       ASSERT_LESS(static_cast<size_t>(value), m_index.size());
       ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
 
@@ -214,15 +288,46 @@ class FixedPriorityQueue
         K const key,
         V const value) noexcept
     {
+      ASSERT_TRUE(m_dirty.empty());
       ASSERT_LESS(static_cast<size_t>(value), m_index.size());
       ASSERT_EQUAL(m_index[value], NULL_INDEX);
 
-      size_t const index = m_size++;
-      m_index[value] = index;
-      m_data[index].key = key;
-      m_data[index].value = value;
+      siftUp(m_size++, key, value);
+    }
+
+
+    /**
+    * @brief Add a set of key-value pairs to the queue at once. Rather than
+    * sifting each pair up as `add()` does, in O(n log n), the pairs are
+    * appended to the heap and it is re-heapified bottom up, in O(size()) time.
+    * This is preferable to calling `add()` when the queue is empty or the
+    * number of pairs is large relative to its size.
+    *
+    * @param keys The keys/priorities of the values to add.
+    * @param values The values to add.
+    * @param num The number of pairs.
+    */
+    void build(
+        K const * const keys,
+        V const * const values,
+        size_t const num) noexcept
+    {
+      ASSERT_TRUE(m_dirty.empty());
+      ASSERT_LESSEQUAL(m_size + num, m_index.size());
+
+      for (size_t i = 0; i < num; ++i) {
+        V const value = values[i];
 
-      siftUp(index);
+        ASSERT_LESS(static_cast<size_t>(value), m_index.size());
+        ASSERT_EQUAL(m_index[value], NULL_INDEX);
+
+        size_t const index = m_size++;
+        m_index[value] = index;
+        m_keys[index] = keys[i];
+        m_values[index] = value;
+      }
+
+      heapify();
     }
 
 
@@ -236,18 +341,11 @@ class FixedPriorityQueue
         K const key,
         V const value) noexcept
     {
+      ASSERT_TRUE(m_dirty.empty());
       ASSERT_LESS(static_cast<size_t>(value), m_index.size());
       ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
 
-      size_t const index = m_index[value];
-      m_data[index].key = key;
-
-      // update position
-      if (index > 0 && key > m_data[parentIndex(index)].key) {
-        siftUp(index);
-      } else {
-        siftDown(index);
-      }
+      sift(m_index[value], key);
     }
 
 
@@ -265,11 +363,100 @@ class FixedPriorityQueue
       ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
 
       size_t const index = m_index[value];
-      K const key = m_data[index].key + delta;
+      K const key = m_keys[index] + delta;
 
       update(key, value);
     }
 
+
+    /**
+    * @brief Give a value a new key without restoring the heap property,
+    * which is deferred until `flush()` is called. This is for when many keys
+    * will change before the next query, such as when updating the neighbors
+    * of a vertex, as a value updated several times is then only sifted once.
+    * `flush()` must be called before any operation other than
+    * `deferUpdate()`, `deferUpdateByDelta()`, `contains()`, `get()`, or
+    * `clear()`.
+    *
+    * @param key The new key for the value.
+    * @param value The value.
+    */
+    void deferUpdate(
+        K const key,
+        V const value)
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_index.size());
+      ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
+
+      m_keys[m_index[value]] = key;
+      if (!m_deferred[value]) {
+        m_deferred[value] = true;
+        m_dirty.emplace_back(value);
+      }
+    }
+
+
+    /**
+    * @brief Change the key of a value by a delta, deferring the restoration
+    * of the heap property until `flush()` is called (see `deferUpdate()`).
+    *
+    * @param delta The change in priority.
+    * @param value The value.
+    */
+    void deferUpdateByDelta(
+        K const delta,
+        V const value)
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_index.size());
+      ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
+
+      deferUpdate(m_keys[m_index[value]] + delta, value);
+    }
+
+
+    /**
+    * @brief Restore the heap property after deferred updates, in
+    * O(k log size()) time for k updated values. The updated values are
+    * first sifted down from the deepest, after which each of their subtrees
+    * is a heap, and then sifted up from the shallowest. If a large fraction
+    * of the heap was updated, it is instead rebuilt in O(size()) time.
+    */
+    void flush()
+    {
+      if (m_dirty.empty()) {
+        return;
+      }
+
+      if (m_dirty.size() * REBUILD_RATIO >= m_size) {
+        for (V const value : m_dirty) {
+          m_deferred[value] = false;
+        }
+        m_dirty.clear();
+        heapify();
+        return;
+      }
+
+      // sifting down only moves values below the one being sifted
+      orderDirty();
+      for (size_t i = m_order.size(); i > 0;) {
+        --i;
+        size_t const index = m_order[i];
+        siftDown(index, m_keys[index], m_values[index]);
+      }
+
+      // and sifting up only moves values above it
+      orderDirty();
+      for (size_t const index : m_order) {
+        siftUp(index, m_keys[index], m_values[index]);
+      }
+
+      for (V const value : m_dirty) {
+        m_deferred[value] = false;
+      }
+      m_dirty.clear();
+    }
+
+
     /**
     * @brief Check if a value in present in the priority queue.
     *
@@ -299,7 +486,7 @@ class FixedPriorityQueue
       ASSERT_LESS(static_cast<size_t>(value), m_index.size());
       ASSERT_NOTEQUAL(m_index[value], NULL_INDEX);
 
-      return m_data[m_index[value]].key;
+      return m_keys[m_index[value]];
     }
 
 
@@ -310,9 +497,10 @@ class FixedPriorityQueue
     */
     V pop() noexcept
     {
+      ASSERT_TRUE(m_dirty.empty());
       ASSERT_GREATER(m_size, 0);
 
-      V const value = m_data[0].value;
+      V const value = m_values[0];
       fill(0);
 
       return value;
@@ -326,18 +514,32 @@ class FixedPriorityQueue
     */
     V const & peek() const noexcept
     {
-      return m_data[0].value;
+      return m_values[0];
     }
 
 
     /**
-    * @brief Get get the top of the priority queue's value.
+    * @brief Get get the top of the priority queue's key. This is the maximum
+    * key for the default ordering.
     *
-    * @return The value.
+    * @return The key.
     */
     K const & max() const noexcept
     {
-      return m_data[0].key;
+      return m_keys[0];
+    }
+
+
+    /**
+    * @brief Get get the top of the priority queue's key. This is an alias of
+    * `max()`, for readability of queues with a reversed ordering (e.g.,
+    * std::greater), where it is the minimum key.
+    *
+    * @return The key.
+    */
+    K const & min() const noexcept
+    {
+      return max();
     }
 
 
@@ -358,15 +560,22 @@ class FixedPriorityQueue
     void clear() noexcept
     {
       for (size_t i = 0; i < m_size; ++i) {
-        m_index[m_data[i].value] = NULL_INDEX;
+        m_index[m_values[i]] = NULL_INDEX;
       }
       m_size = 0;
+
+      for (V const value : m_dirty) {
+        m_deferred[value] = false;
+      }
+      m_dirty.clear();
     }
 
 
     /**
     * @brief Get the set of remaining items in the priority. The order of the
-    * values is arbitrary.
+    * values is arbitrary (it is the order of the heap). Iterating over the
+    * set takes O(size()) time, and the queue must not be modified while
+    * doing so.
     *
     * @return The set of values.
     */
@@ -376,16 +585,96 @@ class FixedPriorityQueue
     }
 
 
-  private:
-    struct kv_pair_struct
+    /**
+    * @brief Remove all values from the queue, writing them in priority order
+    * (the order they would be popped). The heap is sorted in place, which
+    * avoids maintaining the index of each value as popping would.
+    *
+    * @param values The array to write the values to (must be of at least
+    * `size()`).
+    */
+    void drain(
+        V * const values) noexcept
     {
-      K key;
-      V value;
-    };
+      drain(nullptr, values);
+    }
+
 
-    Array<kv_pair_struct> m_data;
+    /**
+    * @brief Remove all key-value pairs from the queue, writing them in
+    * priority order (the order they would be popped).
+    *
+    * @param keys The array to write the keys to (may be null, or must be of
+    * at least `size()`).
+    * @param values The array to write the values to (must be of at least
+    * `size()`).
+    */
+    void drain(
+        K * const keys,
+        V * const values) noexcept
+    {
+      ASSERT_TRUE(m_dirty.empty());
+
+      size_t const num = m_size;
+
+      // move the top to the end of the shrinking heap, which leaves the
+      // pairs in reverse priority order
+      while (m_size > 1) {
+        --m_size;
+        K const topKey = m_keys[0];
+        V const topValue = m_values[0];
+        siftDownUnindexed(0, m_keys[m_size], m_values[m_size]);
+        m_keys[m_size] = topKey;
+        m_values[m_size] = topValue;
+      }
+      m_size = 0;
+
+      for (size_t i = 0; i < num; ++i) {
+        V const value = m_values[num - i - 1];
+        m_index[value] = NULL_INDEX;
+        values[i] = value;
+      }
+      if (keys != nullptr) {
+        for (size_t i = 0; i < num; ++i) {
+          keys[i] = m_keys[num - i - 1];
+        }
+      }
+    }
+
+
+  private:
+    Array<K> m_keyStorage;
+    K * m_keys;
+    Array<V> m_values;
     Array<size_t> m_index;
     size_t m_size;
+    C m_compare;
+    Array<bool> m_deferred;
+    std::vector<V> m_dirty;
+    std::vector<size_t> m_order;
+
+
+    /**
+    * @brief Get the offset of the root's key within the key storage. The
+    * root is placed D-1 elements past the first cache line boundary, so that
+    * the first child of every node (at D*i + 1) is D-aligned relative to
+    * that boundary. If the size of a key does not divide the boundary, the
+    * keys are left unaligned.
+    *
+    * @param storage The key storage.
+    *
+    * @return The offset of the root's key.
+    */
+    static size_t rootOffset(
+        K const * const storage) noexcept
+    {
+      uintptr_t const address = reinterpret_cast<uintptr_t>(storage);
+      uintptr_t const aligned = (address + CACHE_LINE_SIZE - 1) & \
+          ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1);
+      size_t const padding = static_cast<size_t>(aligned - address);
+
+      return (padding % sizeof(K) == 0 ? padding / sizeof(K) : 0) + (D - 1);
+    }
 
 
     /**
@@ -395,56 +684,61 @@ class FixedPriorityQueue
     *
     * @return The index of the parent element.
     */
-    size_t parentIndex(
-        size_t const index) const noexcept
+    static size_t parentIndex(
+        size_t const index) noexcept
     {
-      return index / 2;
+      return (index - 1) / D;
     }
 
 
     /**
-    * @brief Get the index of the left child node.
+    * @brief Get the index of the first child node.
     *
     * @param index The current index.
     *
-    * @return The left child index.
+    * @return The first child index.
     */
-    size_t leftChildIndex(
-        size_t const index) const noexcept
+    static size_t firstChildIndex(
+        size_t const index) noexcept
     {
-      return (index * 2)+1;
+      return (index * D) + 1;
     }
 
 
     /**
-    * @brief Get the index of the right child node.
+    * @brief Move an item from one position to another, leaving a hole in
+    * its original position.
     *
-    * @param index The current index.
-    *
-    * @return The right child index.
+    * @param from The position to move the item from.
+    * @param to The position to move the item to.
     */
-    size_t rightChildIndex(
-        size_t const index) const noexcept
+    void move(
+        size_t const from,
+        size_t const to) noexcept
     {
-      return leftChildIndex(index) + 1;
+      V const value = m_values[from];
+
+      m_keys[to] = m_keys[from];
+      m_values[to] = value;
+      m_index[value] = to;
     }
 
 
     /**
-    * @brief Swap two items within the priority queue.
+    * @brief Write an item into a position.
     *
-    * @param indexA The first value.
-    * @param indexB The second value.
+    * @param index The position.
+    * @param key The item's key.
+    * @param value The item's value.
     */
-    void swap(
-        size_t const indexA,
-        size_t const indexB) noexcept
+    void place(
+        size_t const index,
+        K const key,
+        V const value) noexcept
     {
-      V const valueA = m_data[indexA].value;
-      V const valueB = m_data[indexB].value;
-
-      std::swap(m_index[valueA], m_index[valueB]);
-      std::swap(m_data[indexA], m_data[indexB]);
+      m_keys[index] = key;
+      m_values[index] = value;
+      m_index[value] = index;
     }
 
 
@@ -459,16 +753,15 @@ class FixedPriorityQueue
       ASSERT_LESS(index, m_size);
 
       --m_size;
-      V const deletedValue = m_data[index].value;
+      V const deletedValue = m_values[index];
 
-      if (m_size > 0) {
-        // what we'll do is move the bottom node to this position
-        m_data[index] = m_data[m_size];
-
-        V const value = m_data[index].value;
+      if (index < m_size) {
+        // what we'll do is move the bottom node into the hole, which may
+        // belong above the hole if it was not the root
+        V const value = m_values[m_size];
+        m_values[index] = value;
         m_index[value] = index;
-
-        siftDown(index);
+        sift(index, m_keys[m_size]);
       }
 
       m_index[deletedValue] = NULL_INDEX;
@@ -476,53 +769,229 @@ class FixedPriorityQueue
 
 
     /**
-    * @brief Correctly float an item up into the heap.
+    * @brief Restore the heap property over the entire heap, by sifting down
+    * each internal node from the last to the root (Floyd's method). Most of
+    * the nodes are near the bottom and sift only a level or two, and as the
+    * nodes are visited in reverse order, memory is streamed through rather
+    * than accessed randomly.
+    */
+    void heapify() noexcept
+    {
+      if (m_size <= 1) {
+        return;
+      }
+
+      for (size_t index = parentIndex(m_size-1) + 1; index > 0;) {
+        --index;
+        siftDown(index, m_keys[index], m_values[index]);
+      }
+    }
+
+
+    /**
+    * @brief Get the number of significant bits in a position plus one. As
+    * every child has at least twice the position plus one of its parent,
+    * this is strictly greater for a child than for its parent, and so
+    * orders positions by depth as well as their levels would, while being
+    * cheaper to compute for any arity.
     *
-    * @param index The index of the value to place.
+    * @param index The position.
+    *
+    * @return The number of bits.
+    */
+    static size_t depthBits(
+        size_t const index) noexcept
+    {
+      #if defined(__GNUC__) || defined(__clang__)
+      return (sizeof(unsigned long long)*8) - \
+          static_cast<size_t>(__builtin_clzll( \
+              static_cast<unsigned long long>(index) + 1));
+      #else
+      size_t bits = 0;
+      for (size_t i = index + 1; i != 0; i >>= 1) {
+        ++bits;
+      }
+      return bits;
+      #endif
+    }
+
+
+    /**
+    * @brief Write the positions of the values with deferred updates to
+    * m_order, ordered from the root down such that every position comes
+    * after those of its ancestors. This is a counting sort on `depthBits()`.
+    * The keys each position will be compared with are prefetched, so that
+    * the cache misses of the sifts overlap.
+    */
+    void orderDirty()
+    {
+      constexpr size_t const MAX_BITS = sizeof(size_t) * 8;
+
+      size_t counts[MAX_BITS + 1] = {};
+      for (V const value : m_dirty) {
+        ++counts[depthBits(m_index[value]) - 1];
+      }
+
+      size_t offset = 0;
+      for (size_t bits = 0; bits <= MAX_BITS; ++bits) {
+        size_t const count = counts[bits];
+        counts[bits] = offset;
+        offset += count;
+      }
+
+      m_order.resize(m_dirty.size());
+      for (V const value : m_dirty) {
+        size_t const index = m_index[value];
+        m_order[counts[depthBits(index) - 1]++] = index;
+
+        Prefetch::write(m_values.data() + index);
+        if (firstChildIndex(index) < m_size) {
+          Prefetch::read(m_keys + firstChildIndex(index));
+        }
+        if (index > 0) {
+          Prefetch::read(m_keys + parentIndex(index));
+        }
+      }
+    }
+
+
+    /**
+    * @brief Give the item at a position a new key, and move it up or down to
+    * its correct place in the heap. Most updates do not move the item, in
+    * which case only the key is written.
+    *
+    * @param index The position of the item.
+    * @param key The item's new key.
+    */
+    void sift(
+        size_t const index,
+        K const key) noexcept
+    {
+      if (index > 0 && m_compare(m_keys[parentIndex(index)], key)) {
+        siftUp(index, key, m_values[index]);
+      } else {
+        size_t const child = bestChildIndex(index);
+        if (child < m_size && m_compare(key, m_keys[child])) {
+          siftDown(index, key, m_values[index]);
+        } else {
+          m_keys[index] = key;
+        }
+      }
+    }
+
+
+    /**
+    * @brief Get the index of the highest priority child of a node.
+    *
+    * @param index The index of the node.
+    *
+    * @return The index of the child, or at least m_size if the node has no
+    * children.
+    */
+    size_t bestChildIndex(
+        size_t const index) const noexcept
+    {
+      size_t const firstIndex = firstChildIndex(index);
+      size_t const endIndex = std::min(firstIndex + D, m_size);
+
+      size_t maxIndex = firstIndex;
+      for (size_t child = firstIndex + 1; child < endIndex; ++child) {
+        if (m_compare(m_keys[maxIndex], m_keys[child])) {
+          maxIndex = child;
+        }
+      }
+
+      return maxIndex;
+    }
+
+
+    /**
+    * @brief Correctly float an item up into the heap. Rather than swapping
+    * the item with each parent, the parents are moved down into the hole,
+    * and the item is written once at its final position.
+    *
+    * @param index The position of the hole to start from.
+    * @param key The item's key.
+    * @param value The item's value.
     */
     void siftUp(
-        size_t index) noexcept
+        size_t index,
+        K const key,
+        V const value) noexcept
     {
       while (index > 0) {
         size_t const parent = parentIndex(index);
-        if (m_data[parent].key >= m_data[index].key) {
+        if (!m_compare(m_keys[parent], key)) {
           // reached a valid state
           break;
         }
-        swap(index, parent);
+        move(parent, index);
         index = parent;
       }
+
+      place(index, key, value);
     }
 
 
     /**
-    * @brief Correctly sink an item up into the heap.
+    * @brief Sink an item into the heap as `siftDown()` does, but without
+    * maintaining the index of the values moved.
     *
-    * @param index The index of the value to place.
+    * @param index The position of the hole to start from.
+    * @param key The item's key.
+    * @param value The item's value.
+    */
+    void siftDownUnindexed(
+        size_t index,
+        K const key,
+        V const value) noexcept
+    {
+      while (true) {
+        size_t const maxIndex = bestChildIndex(index);
+        if (maxIndex >= m_size || !m_compare(key, m_keys[maxIndex])) {
+          break;
+        }
+        m_keys[index] = m_keys[maxIndex];
+        m_values[index] = m_values[maxIndex];
+        index = maxIndex;
+      }
+
+      m_keys[index] = key;
+      m_values[index] = value;
+    }
+
+
+    /**
+    * @brief Correctly sink an item into the heap. Rather than swapping the
+    * item with each child, the children are moved up into the hole, and the
+    * item is written once at its final position.
+    *
+    * @param index The position of the hole to start from.
+    * @param key The item's key.
+    * @param value The item's value.
     */
     void siftDown(
-        size_t index) noexcept
+        size_t index,
+        K const key,
+        V const value) noexcept
     {
-      K const key = m_data[index].key;
       while (true) {
-        size_t const leftIndex = leftChildIndex(index);
-        size_t const rightIndex = rightChildIndex(index);
-        if (rightIndex < m_size && key < m_data[rightIndex].key) {
-          if (m_data[rightIndex].key >= m_data[leftIndex].key) {
-            swap(index, rightIndex);
-            index = rightIndex;
-          } else {
-            swap(index, leftIndex);
-            index = leftIndex;
-          }
-        } else if (leftIndex < m_size && key < m_data[leftIndex].key) {
-          swap(index, leftIndex);
-          index = leftIndex;
+        size_t const maxIndex = bestChildIndex(index);
+        if (maxIndex >= m_size) {
+          // no children
+          break;
+        }
+
+        if (m_compare(key, m_keys[maxIndex])) {
+          move(maxIndex, index);
+          index = maxIndex;
         } else {
           // life is good -- exit
           break;
         }
       }
+
+      place(index, key, value);
     }
 };
 
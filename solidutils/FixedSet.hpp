@@ -32,6 +32,8 @@
 
 
 #include "Array.hpp"
+#include "BoundedSort.hpp"
+#include "Prefetch.hpp"
 
 
 namespace sl
@@ -104,6 +106,58 @@ class FixedSet
     }
 
 
+    /**
+    * @brief Check if a batch of elements exist in this set. Lookups are
+    * software pipelined, prefetching the index entries of elements ahead of
+    * the current one so that the cache misses of independent elements overlap.
+    *
+    * @param elements The elements to check for.
+    * @param num The number of elements.
+    * @param out The output array of whether each element is in the set (must
+    * be of length num).
+    */
+    void hasMany(
+        T const * const elements,
+        size_t const num,
+        bool * const out) const noexcept
+    {
+      constexpr size_t const dist = Prefetch::DISTANCE;
+
+      for (size_t i = 0; i < num; ++i) {
+        if (i + dist < num) {
+          Prefetch::read(m_index.data() + \
+              static_cast<size_t>(elements[i+dist]));
+        }
+        out[i] = has(elements[i]);
+      }
+    }
+
+
+    /**
+    * @brief Add a batch of elements to this set. None of the elements may
+    * already be present, and the elements must be unique.
+    *
+    * @param elements The elements to add.
+    * @param num The number of elements.
+    */
+    void addMany(
+        T const * const elements,
+        size_t const num) noexcept
+    {
+      constexpr size_t const dist = Prefetch::DISTANCE;
+
+      ASSERT_LESSEQUAL(m_size + num, m_data.size());
+
+      for (size_t i = 0; i < num; ++i) {
+        if (i + dist < num) {
+          Prefetch::write(m_index.data() + \
+              static_cast<size_t>(elements[i+dist]));
+        }
+        add(elements[i]);
+      }
+    }
+
+
     /**
     * @brief Remove an element from this set.
     *
@@ -126,6 +180,170 @@ class FixedSet
     }
 
 
+    /**
+    * @brief Remove all elements from this set. This is O(size()), not
+    * O(maxSize()).
+    */
+    void clear() noexcept
+    {
+      for (size_t i = 0; i < m_size; ++i) {
+        m_index[static_cast<size_t>(m_data[i])] = NULL_INDEX;
+      }
+      m_size = 0;
+    }
+
+
+    /**
+    * @brief Get the maximum size of this set.
+    *
+    * @return The maximum size.
+    */
+    size_t maxSize() const noexcept
+    {
+      return m_index.size();
+    }
+
+
+    /**
+    * @brief Count the number of elements in both this set and another. The
+    * smaller set is iterated, and the larger probed.
+    *
+    * @param other The other set (must have the same maximum size).
+    *
+    * @return The number of shared elements.
+    */
+    size_t intersectionSize(
+        FixedSet const & other) const noexcept
+    {
+      ASSERT_EQUAL(maxSize(), other.maxSize());
+
+      FixedSet const & dense = m_size <= other.m_size ? *this : other;
+      FixedSet const & probe = m_size <= other.m_size ? other : *this;
+
+      size_t count = 0;
+      for (size_t i = 0; i < dense.m_size; ++i) {
+        dense.prefetchProbe(probe, i);
+        if (probe.has(dense.m_data[i])) {
+          ++count;
+        }
+      }
+
+      return count;
+    }
+
+
+    /**
+    * @brief Find the elements present in both this set and another. The
+    * smaller set is iterated, and the larger probed.
+    *
+    * @param other The other set (must have the same maximum size).
+    * @param out The set to write the intersection to (will be cleared first,
+    * and must be neither this nor the other set).
+    */
+    void intersect(
+        FixedSet const & other,
+        FixedSet & out) const noexcept
+    {
+      ASSERT_TRUE(&out != this && &out != &other);
+      ASSERT_EQUAL(maxSize(), other.maxSize());
+
+      FixedSet const & dense = m_size <= other.m_size ? *this : other;
+      FixedSet const & probe = m_size <= other.m_size ? other : *this;
+
+      out.clear();
+      for (size_t i = 0; i < dense.m_size; ++i) {
+        dense.prefetchProbe(probe, i);
+        T const element = dense.m_data[i];
+        if (probe.has(element)) {
+          out.add(element);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Find the elements present in either this set or another.
+    *
+    * @param other The other set (must have the same maximum size).
+    * @param out The set to write the union to (will be cleared first, and
+    * must be neither this nor the other set).
+    */
+    void unite(
+        FixedSet const & other,
+        FixedSet & out) const noexcept
+    {
+      ASSERT_TRUE(&out != this && &out != &other);
+      ASSERT_EQUAL(maxSize(), other.maxSize());
+
+      out.clear();
+      for (size_t i = 0; i < m_size; ++i) {
+        out.add(m_data[i]);
+      }
+      for (size_t i = 0; i < other.m_size; ++i) {
+        other.prefetchProbe(*this, i);
+        T const element = other.m_data[i];
+        if (!has(element)) {
+          out.add(element);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Find the elements present in this set but not in another.
+    *
+    * @param other The other set (must have the same maximum size).
+    * @param out The set to write the difference to (will be cleared first,
+    * and must be neither this nor the other set).
+    */
+    void difference(
+        FixedSet const & other,
+        FixedSet & out) const noexcept
+    {
+      ASSERT_TRUE(&out != this && &out != &other);
+      ASSERT_EQUAL(maxSize(), other.maxSize());
+
+      out.clear();
+      for (size_t i = 0; i < m_size; ++i) {
+        prefetchProbe(other, i);
+        T const element = m_data[i];
+        if (!other.has(element)) {
+          out.add(element);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Get a copy of the elements of this set in ascending order. This
+    * does not modify the set.
+    *
+    * @return The sorted elements.
+    */
+    Array<T> sortedKeys() const
+    {
+      Array<T> keys(m_size);
+      writeSorted(keys.data());
+
+      return keys;
+    }
+
+
+    /**
+    * @brief Re-order the elements of this set such that iteration is in
+    * ascending order. The order is maintained until the next call to
+    * `remove()`.
+    */
+    void sortInPlace()
+    {
+      writeSorted(m_data.data());
+
+      for (size_t i = 0; i < m_size; ++i) {
+        m_index[static_cast<size_t>(m_data[i])] = i;
+      }
+    }
+
+
     /**
     * @brief Get the underlying array.
     *
@@ -206,9 +424,62 @@ class FixedSet
 
 
   private:
+    /**
+    * @brief When the set holds at least 1/DENSE_SORT_RATIO of the possible
+    * elements, sorting is done by scanning the index rather than via radix
+    * sort.
+    */
+    static constexpr size_t const DENSE_SORT_RATIO = 16;
+
     size_t m_size;
     Array<T> m_data;
     Array<T> m_index;
+
+
+    /**
+    * @brief Prefetch the index entry of another set for the element
+    * Prefetch::DISTANCE positions after the given position in this set.
+    *
+    * @param probe The set that will be probed.
+    * @param i The current position in this set.
+    */
+    void prefetchProbe(
+        FixedSet const & probe,
+        size_t const i) const noexcept
+    {
+      if (i + Prefetch::DISTANCE < m_size) {
+        size_t const index = static_cast<size_t>(m_data[i+Prefetch::DISTANCE]);
+        Prefetch::read(probe.m_index.data() + index);
+      }
+    }
+
+
+    /**
+    * @brief Write the elements of the set in ascending order. The index is
+    * not modified.
+    *
+    * @param out The location to write the elements to (may be the set's own
+    * data).
+    */
+    void writeSorted(
+        T * const out) const
+    {
+      if (m_size * DENSE_SORT_RATIO >= m_index.size()) {
+        // the index is already a histogram over the universe
+        size_t j = 0;
+        for (size_t k = 0; j < m_size; ++k) {
+          if (m_index[k] != NULL_INDEX) {
+            out[j++] = static_cast<T>(k);
+          }
+        }
+      } else {
+        if (out != m_data.data()) {
+          std::copy(begin(), end(), out);
+        }
+        Array<T> scratch(m_size);
+        BoundedSort::radix(out, m_size, m_index.size(), scratch.data());
+      }
+    }
 };
 
 }
@@ -0,0 +1,518 @@
+/**
+* @file MultiQueue.hpp
+* @brief The MultiQueue class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-20
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_MULTIQUEUE_HPP
+#define SOLIDUTILS_INCLUDE_MULTIQUEUE_HPP
+
+
+#include "Array.hpp"
+#include "FixedPriorityQueue.hpp"
+#include "Random.hpp"
+#include "Spinlock.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+/**
+* @brief The MultiQueue class provides a relaxed priority queue which can be
+* shared by multiple threads. It is made up of several FixedPriorityQueues,
+* each behind a spinlock. Values are added to a random queue, and popped from
+* the better of two random queues, so the value popped is only approximately
+* the top of the whole structure, but threads rarely contend for a lock.
+*
+* Each value's queue is tracked, so that values can be updated or removed as
+* with FixedPriorityQueue. As each queue is value indexed, memory use is
+* O(max) per queue.
+*
+* ```
+* MultiQueue<float, int> pq(n, numThreads);
+*
+* // on each thread
+* pq.add(threadId, key, value);
+* ...
+* int const value = pq.pop(threadId);
+* if (value != pq.NULL_VALUE) {
+*   ...
+* }
+* ```
+*
+* @tparam K The key type.
+* @tparam V The value type.
+* @tparam D The arity of each queue's heap.
+* @tparam C The comparator of keys.
+*/
+template<typename K, typename V, size_t D = 4, typename C = std::less<K>>
+class MultiQueue
+{
+  public:
+    static constexpr V const NULL_VALUE = static_cast<V>(-1);
+
+    /**
+    * @brief The default number of queues to create per thread.
+    */
+    static constexpr size_t const QUEUES_PER_THREAD = 2;
+
+    /**
+    * @brief Create a new empty multiqueue that can hold elements 0 through
+    * max.
+    *
+    * @param max The max value in the queue (exclusive).
+    * @param numThreads The number of threads that will access the queue.
+    * @param queuesPerThread The number of queues to create per thread.
+    * @param compare The comparator to order keys with.
+    */
+    MultiQueue(
+        V const max,
+        size_t const numThreads,
+        size_t const queuesPerThread = QUEUES_PER_THREAD,
+        C const & compare = C()) :
+      m_queues(),
+      m_owner(max),
+      m_rngs(),
+      m_compare(compare)
+    {
+      size_t const threads = std::max(numThreads, static_cast<size_t>(1));
+      m_rngs.reserve(threads);
+      for (size_t t = 0; t < threads; ++t) {
+        m_rngs.emplace_back(static_cast<uint32_t>(t+1));
+      }
+
+      size_t const numQueues = std::max(threads*queuesPerThread, \
+          static_cast<size_t>(2));
+      m_queues.reserve(numQueues);
+      for (size_t q = 0; q < numQueues; ++q) {
+        m_queues.emplace_back(new queue_struct(max, compare));
+      }
+
+      for (size_t v = 0; v < m_owner.size(); ++v) {
+        m_owner[v].store(NO_OWNER, std::memory_order_relaxed);
+      }
+    }
+
+
+    /**
+    * @brief Add a value to a random queue.
+    *
+    * @param threadId The id of the calling thread.
+    * @param key The key/priority of the value to add.
+    * @param value The value to add.
+    */
+    void add(
+        size_t const threadId,
+        K const key,
+        V const value) noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_owner.size());
+      ASSERT_EQUAL(m_owner[value].load(), NO_OWNER);
+
+      queue_struct * queue;
+      size_t index;
+      do {
+        index = randomQueue(threadId);
+        queue = m_queues[index].get();
+      } while (!queue->lock.try_lock());
+
+      queue->pq.add(key, value);
+      m_owner[value].store(static_cast<uint32_t>(index), \
+          std::memory_order_relaxed);
+      publish(*queue);
+
+      queue->lock.unlock();
+    }
+
+
+    /**
+    * @brief Pop the top value from the better of two random queues. If both
+    * are empty, all queues are checked.
+    *
+    * @param threadId The id of the calling thread.
+    *
+    * @return The value, or NULL_VALUE if all queues were found empty.
+    */
+    V pop(
+        size_t const threadId) noexcept
+    {
+      while (true) {
+        size_t const first = randomQueue(threadId);
+        size_t second = randomQueue(threadId);
+        if (second == first) {
+          second = (first + 1) % m_queues.size();
+        }
+
+        size_t const best = better(first, second);
+        if (best == NO_QUEUE) {
+          return popAny();
+        }
+
+        queue_struct & queue = *m_queues[best];
+        if (queue.lock.try_lock()) {
+          // the queue may have been emptied since we checked
+          if (queue.pq.size() > 0) {
+            V const value = queue.pq.pop();
+            m_owner[value].store(NO_OWNER, std::memory_order_relaxed);
+            publish(queue);
+            queue.lock.unlock();
+            return value;
+          }
+          queue.lock.unlock();
+        }
+      }
+    }
+
+
+    /**
+    * @brief Update the key associated with a given value.
+    *
+    * @param key The new key for the value.
+    * @param value The value.
+    *
+    * @return False if the value was not present (e.g., if it was popped by
+    * another thread).
+    */
+    bool update(
+        K const key,
+        V const value) noexcept
+    {
+      queue_struct * const queue = lockOwner(value);
+      if (queue == nullptr) {
+        return false;
+      }
+
+      queue->pq.update(key, value);
+      publish(*queue);
+      queue->lock.unlock();
+
+      return true;
+    }
+
+
+    /**
+    * @brief Remove a value from the queue.
+    *
+    * @param value The value.
+    *
+    * @return False if the value was not present (e.g., if it was popped by
+    * another thread).
+    */
+    bool remove(
+        V const value) noexcept
+    {
+      queue_struct * const queue = lockOwner(value);
+      if (queue == nullptr) {
+        return false;
+      }
+
+      queue->pq.remove(value);
+      m_owner[value].store(NO_OWNER, std::memory_order_relaxed);
+      publish(*queue);
+      queue->lock.unlock();
+
+      return true;
+    }
+
+
+    /**
+    * @brief Check if a value is present in the queue. If other threads are
+    * modifying the queue, the result may be stale.
+    *
+    * @param value The value to check for.
+    *
+    * @return Whether or not the value is present.
+    */
+    bool contains(
+        V const value) const noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_owner.size());
+
+      return m_owner[value].load(std::memory_order_relaxed) != NO_OWNER;
+    }
+
+
+    /**
+    * @brief Get the key associated with the given value.
+    *
+    * @param value The value (must be present).
+    *
+    * @return The key.
+    */
+    K get(
+        V const value) const noexcept
+    {
+      queue_struct * const queue = lockOwner(value);
+      ASSERT_NOTNULL(queue);
+
+      K const key = queue->pq.get(value);
+      queue->lock.unlock();
+
+      return key;
+    }
+
+
+    /**
+    * @brief Get the number of elements in the queue. If other threads are
+    * modifying the queue, this is approximate.
+    *
+    * @return The number of elements.
+    */
+    size_t size() const noexcept
+    {
+      size_t total = 0;
+      for (std::unique_ptr<queue_struct> const & queue : m_queues) {
+        total += queue->size.load(std::memory_order_relaxed);
+      }
+      return total;
+    }
+
+
+    /**
+    * @brief Get the number of underlying queues.
+    *
+    * @return The number of queues.
+    */
+    size_t numQueues() const noexcept
+    {
+      return m_queues.size();
+    }
+
+
+    /**
+    * @brief Remove all values. This must not be called concurrently with
+    * other operations.
+    */
+    void clear() noexcept
+    {
+      for (std::unique_ptr<queue_struct> & queue : m_queues) {
+        for (V const value : queue->pq.remaining()) {
+          m_owner[value].store(NO_OWNER, std::memory_order_relaxed);
+        }
+        queue->pq.clear();
+        publish(*queue);
+      }
+    }
+
+
+  private:
+    static constexpr uint32_t const NO_OWNER = UINT32_MAX;
+    static constexpr size_t const NO_QUEUE = static_cast<size_t>(-1);
+    static constexpr size_t const CACHE_LINE_SIZE = 64;
+
+    /**
+    * @brief A queue and its lock, along with its size and top key, which are
+    * published for other threads to read without locking.
+    */
+    struct queue_struct
+    {
+      queue_struct(
+          V const max,
+          C const & compare) :
+        lock(),
+        size(0),
+        top(),
+        pq(max, compare)
+      {
+        // do nothing
+      }
+
+      Spinlock lock;
+      std::atomic<size_t> size;
+      std::atomic<K> top;
+      FixedPriorityQueue<K, V, D, C> pq;
+      char padding[CACHE_LINE_SIZE];
+    };
+
+    /**
+    * @brief A thread's random source, padded to avoid false sharing.
+    */
+    struct rng_struct
+    {
+      rng_struct(
+          uint32_t const seed) :
+        rng(seed),
+        padding()
+      {
+        // do nothing
+      }
+
+      std::minstd_rand rng;
+      char padding[CACHE_LINE_SIZE];
+    };
+
+    std::vector<std::unique_ptr<queue_struct>> m_queues;
+    Array<std::atomic<uint32_t>> m_owner;
+    std::vector<rng_struct> m_rngs;
+    C m_compare;
+
+
+    /**
+    * @brief Select a random queue.
+    *
+    * @param threadId The id of the calling thread.
+    *
+    * @return The index of the queue.
+    */
+    size_t randomQueue(
+        size_t const threadId) noexcept
+    {
+      ASSERT_LESS(threadId, m_rngs.size());
+
+      return Random::inRange(static_cast<size_t>(0), m_queues.size(), \
+          m_rngs[threadId].rng);
+    }
+
+
+    /**
+    * @brief Publish a queue's size and top key. The queue must be locked.
+    *
+    * @param queue The queue.
+    */
+    static void publish(
+        queue_struct & queue) noexcept
+    {
+      size_t const size = queue.pq.size();
+      if (size > 0) {
+        queue.top.store(queue.pq.max(), std::memory_order_relaxed);
+      }
+      queue.size.store(size, std::memory_order_release);
+    }
+
+
+    /**
+    * @brief Choose the queue with the better top key, based on their
+    * published state.
+    *
+    * @param first The first queue.
+    * @param second The second queue.
+    *
+    * @return The better queue, or NO_QUEUE if both are empty.
+    */
+    size_t better(
+        size_t const first,
+        size_t const second) const noexcept
+    {
+      queue_struct const & a = *m_queues[first];
+      queue_struct const & b = *m_queues[second];
+
+      bool const hasA = a.size.load(std::memory_order_acquire) > 0;
+      bool const hasB = b.size.load(std::memory_order_acquire) > 0;
+
+      if (hasA && hasB) {
+        return m_compare(a.top.load(std::memory_order_relaxed), \
+            b.top.load(std::memory_order_relaxed)) ? second : first;
+      } else if (hasA) {
+        return first;
+      } else if (hasB) {
+        return second;
+      } else {
+        return NO_QUEUE;
+      }
+    }
+
+
+    /**
+    * @brief Pop from the first non-empty queue, checking every queue.
+    *
+    * @return The value, or NULL_VALUE if every queue was empty.
+    */
+    V popAny() noexcept
+    {
+      for (std::unique_ptr<queue_struct> & queue : m_queues) {
+        if (queue->size.load(std::memory_order_acquire) > 0) {
+          std::lock_guard<Spinlock> guard(queue->lock);
+          if (queue->pq.size() > 0) {
+            V const value = queue->pq.pop();
+            m_owner[value].store(NO_OWNER, std::memory_order_relaxed);
+            publish(*queue);
+            return value;
+          }
+        }
+      }
+
+      return NULL_VALUE;
+    }
+
+
+    /**
+    * @brief Lock the queue which holds a value. As the value may move between
+    * reading its owner and acquiring the lock, the owner is re-checked once
+    * locked.
+    *
+    * @param value The value.
+    *
+    * @return The locked queue, or nullptr if the value is not present.
+    */
+    queue_struct * lockOwner(
+        V const value) const noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_owner.size());
+
+      while (true) {
+        uint32_t const owner = m_owner[value].load(std::memory_order_relaxed);
+        if (owner == NO_OWNER) {
+          return nullptr;
+        }
+
+        queue_struct * const queue = m_queues[owner].get();
+        queue->lock.lock();
+        if (m_owner[value].load(std::memory_order_relaxed) == owner) {
+          return queue;
+        }
+        queue->lock.unlock();
+      }
+    }
+};
+
+
+template<typename K, typename V, size_t D, typename C>
+constexpr V const MultiQueue<K, V, D, C>::NULL_VALUE;
+
+template<typename K, typename V, size_t D, typename C>
+constexpr size_t const MultiQueue<K, V, D, C>::QUEUES_PER_THREAD;
+
+template<typename K, typename V, size_t D, typename C>
+constexpr uint32_t const MultiQueue<K, V, D, C>::NO_OWNER;
+
+template<typename K, typename V, size_t D, typename C>
+constexpr size_t const MultiQueue<K, V, D, C>::NO_QUEUE;
+
+template<typename K, typename V, size_t D, typename C>
+constexpr size_t const MultiQueue<K, V, D, C>::CACHE_LINE_SIZE;
+
+}
+
+
+#endif
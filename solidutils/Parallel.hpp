@@ -0,0 +1,148 @@
+/**
+* @file Parallel.hpp
+* @brief The Parallel class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-16
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef SOLIDUTILS_INCLUDE_PARALLEL_HPP
+#define SOLIDUTILS_INCLUDE_PARALLEL_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace sl
+{
+
+/**
+* @brief The Parallel class provides static functions for running work on
+* multiple threads. Each call forks the requested number of threads and joins
+* them before returning, so consecutive calls act as barriers. Users needing
+* parallelism should link with the system's thread library (e.g.,
+* `-pthread`).
+*/
+class Parallel
+{
+  public:
+    /**
+    * @brief Get the number of threads to use by default (the number of
+    * hardware threads).
+    *
+    * @return The number of threads.
+    */
+    static size_t defaultThreads() noexcept
+    {
+      size_t const num = std::thread::hardware_concurrency();
+      return num > 0 ? num : 1;
+    }
+
+
+    /**
+    * @brief Execute a function on a number of threads. The calling thread
+    * executes as thread 0.
+    *
+    * @tparam F The type of function, callable as `func(size_t threadId)`.
+    * @param numThreads The number of threads.
+    * @param func The function.
+    */
+    template<typename F>
+    static void run(
+        size_t const numThreads,
+        F const & func)
+    {
+      if (numThreads <= 1) {
+        func(static_cast<size_t>(0));
+        return;
+      }
+
+      std::vector<std::thread> threads;
+      threads.reserve(numThreads-1);
+      for (size_t t = 1; t < numThreads; ++t) {
+        threads.emplace_back(func, t);
+      }
+
+      func(static_cast<size_t>(0));
+
+      for (std::thread & thread : threads) {
+        thread.join();
+      }
+    }
+
+
+    /**
+    * @brief Execute a function on each index in [0,num) using a number of
+    * threads. Indices are claimed dynamically, so work of uneven size is
+    * balanced across the threads.
+    *
+    * @tparam F The type of function, callable as
+    * `func(size_t index, size_t threadId)`.
+    * @param numThreads The number of threads.
+    * @param num The number of indices.
+    * @param func The function.
+    */
+    template<typename F>
+    static void forDynamic(
+        size_t const numThreads,
+        size_t const num,
+        F const & func)
+    {
+      std::atomic<size_t> next(0);
+      run(numThreads, [&next, num, &func](size_t const threadId) {
+        for (size_t i = next++; i < num; i = next++) {
+          func(i, threadId);
+        }
+      });
+    }
+
+
+    /**
+    * @brief Get the start of the given thread's block when dividing a range
+    * of elements evenly among threads.
+    *
+    * @param num The number of elements.
+    * @param threadId The thread.
+    * @param numThreads The number of threads.
+    *
+    * @return The first element of the block.
+    */
+    static size_t blockStart(
+        size_t const num,
+        size_t const threadId,
+        size_t const numThreads) noexcept
+    {
+      size_t const base = num / numThreads;
+      size_t const extra = num % numThreads;
+
+      return base*threadId + (threadId < extra ? threadId : extra);
+    }
+};
+
+}
+
+
+#endif
@@ -0,0 +1,100 @@
+/**
+* @file Prefetch.hpp
+* @brief The Prefetch class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-02
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef SOLIDUTILS_INCLUDE_PREFETCH_HPP
+#define SOLIDUTILS_INCLUDE_PREFETCH_HPP
+
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+#include <cstddef>
+
+
+namespace sl
+{
+
+/**
+* @brief The Prefetch class provides portable software prefetch hints. On
+* compilers without a prefetch intrinsic these are no-ops.
+*/
+class Prefetch
+{
+  public:
+    /**
+    * @brief The number of elements ahead of the current one that batched
+    * operations issue prefetches for. This needs to be large enough to cover
+    * memory latency, but small enough the lines are not evicted before use.
+    */
+    static constexpr size_t const DISTANCE = 16;
+
+    /**
+    * @brief Hint that the given address will be read soon.
+    *
+    * @tparam T The type of memory.
+    * @param ptr The address.
+    */
+    template<typename T>
+    static inline void read(
+        T const * const ptr) noexcept
+    {
+      #if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(static_cast<void const *>(ptr), 0, 3);
+      #elif defined(_MSC_VER)
+      _mm_prefetch(reinterpret_cast<char const *>(ptr), _MM_HINT_T0);
+      #else
+      (void)ptr;
+      #endif
+    }
+
+
+    /**
+    * @brief Hint that the given address will be written soon.
+    *
+    * @tparam T The type of memory.
+    * @param ptr The address.
+    */
+    template<typename T>
+    static inline void write(
+        T const * const ptr) noexcept
+    {
+      #if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(static_cast<void const *>(ptr), 1, 3);
+      #elif defined(_MSC_VER)
+      _mm_prefetch(reinterpret_cast<char const *>(ptr), _MM_HINT_T0);
+      #else
+      (void)ptr;
+      #endif
+    }
+};
+
+}
+
+
+#endif
@@ -0,0 +1,396 @@
+/**
+ * @file RadixHeap.hpp
+ * @brief The RadixHeap class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-04-13
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_RADIXHEAP_HPP
+#define SOLIDUTILS_INCLUDE_RADIXHEAP_HPP
+
+#include "Array.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace sl
+{
+
+
+/**
+* @brief The RadixHeap class provides a min priority queue for unsigned
+* integer keys, where the keys popped are non-decreasing, as in Dijkstra's
+* algorithm. Key-value pairs are stored in buckets according to the highest
+* bit in which their key differs from the last key popped. When the lowest
+* bucket is empty, the next non-empty bucket is redistributed into the
+* buckets below it, and as each pair can only move down, each operation costs
+* amortized O(log C) for keys in a range of C. Each bucket is a contiguous
+* array, so redistribution reads and writes the pairs sequentially.
+*
+* Keys added, or updated, may not be less than the last key popped. Like
+* FixedPriorityQueue, values are in the range [0,max), and can be looked up
+* via `contains()` and `get()`.
+*
+* @tparam K The key type (must be an unsigned integer).
+* @tparam V The value type (must be integral).
+*/
+template<typename K, typename V>
+class RadixHeap
+{
+  public:
+    static_assert(std::is_integral<K>::value && std::is_unsigned<K>::value, \
+        "Must be an unsigned integral type.");
+    static_assert(std::is_integral<V>::value, "Must by integral type.");
+
+    /**
+    * @brief The number of buckets: one for the last key popped, and one for
+    * each bit of the key.
+    */
+    static constexpr size_t const NUM_BUCKETS = (sizeof(K)*8) + 1;
+
+    /**
+    * @brief Create a new priority queue that can hold elements 0 through max.
+    *
+    * @param max The max value in the priority queue (exclusive).
+    */
+    RadixHeap(
+        V const max) :
+      m_position(max),
+      m_bucket(max, NO_BUCKET),
+      m_buckets(),
+      m_last(0),
+      m_size(0)
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Remove an element from the queue.
+    *
+    * @param value The element to remove
+    */
+    void remove(
+        V const value) noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      unlink(value);
+      m_bucket[value] = NO_BUCKET;
+      --m_size;
+    }
+
+
+    /**
+    * @brief Add an value to the queue.
+    *
+    * @param key The key/priority of the value to add (may not be less than
+    * the last key popped).
+    * @param value The value to add.
+    */
+    void add(
+        K const key,
+        V const value)
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_bucket.size());
+      ASSERT_EQUAL(m_bucket[value], NO_BUCKET);
+      ASSERT_GREATEREQUAL(key, m_last);
+
+      link(key, value, bucketOf(key));
+      ++m_size;
+    }
+
+
+    /**
+    * @brief Update the key associated with a given value. Typically this is
+    * a decrease of the key, but the new key may not be less than the last key
+    * popped.
+    *
+    * @param key The new key for the value.
+    * @param value The value.
+    */
+    void update(
+        K const key,
+        V const value)
+    {
+      ASSERT_TRUE(contains(value));
+      ASSERT_GREATEREQUAL(key, m_last);
+
+      size_t const bucket = bucketOf(key);
+      if (bucket == m_bucket[value]) {
+        m_buckets[bucket][m_position[value]].key = key;
+      } else {
+        unlink(value);
+        link(key, value, bucket);
+      }
+    }
+
+
+    /**
+    * @brief Check if a value in present in the priority queue.
+    *
+    * @param value The value to check for.
+    *
+    * @return Whether or not the value is present.
+    */
+    bool contains(
+        V const value) const noexcept
+    {
+      ASSERT_LESS(static_cast<size_t>(value), m_bucket.size());
+
+      return m_bucket[value] != NO_BUCKET;
+    }
+
+
+    /**
+    * @brief Get the key associated with the given value.
+    *
+    * @param value The value.
+    *
+    * @return The key.
+    */
+    K get(
+        V const value) const noexcept
+    {
+      ASSERT_TRUE(contains(value));
+
+      return m_buckets[m_bucket[value]][m_position[value]].key;
+    }
+
+
+    /**
+    * @brief Pop the value with the minimum key from the queue.
+    *
+    * @return The value.
+    */
+    V pop()
+    {
+      V const value = peek();
+      remove(value);
+
+      return value;
+    }
+
+
+    /**
+    * @brief Get the value with the minimum key. This may redistribute a
+    * bucket, and so is not const.
+    *
+    * @return The value.
+    */
+    V peek()
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      if (m_buckets[0].empty()) {
+        redistribute();
+      }
+
+      return m_buckets[0].back().value;
+    }
+
+
+    /**
+    * @brief Get the minimum key. This may redistribute a bucket, and so is
+    * not const.
+    *
+    * @return The key.
+    */
+    K min()
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      if (m_buckets[0].empty()) {
+        redistribute();
+      }
+
+      return m_last;
+    }
+
+
+    /**
+    * @brief Get the number of elements in the queue.
+    *
+    * @return The number of elements.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Clear entries from the priority queue, and reset the last key
+    * popped to zero. Bucket memory is retained for re-use.
+    */
+    void clear() noexcept
+    {
+      for (std::vector<kv_pair_struct> & bucket : m_buckets) {
+        for (kv_pair_struct const & pair : bucket) {
+          m_bucket[pair.value] = NO_BUCKET;
+        }
+        bucket.clear();
+      }
+      m_last = 0;
+      m_size = 0;
+    }
+
+
+  private:
+    static constexpr uint8_t const NO_BUCKET = UINT8_MAX;
+
+    struct kv_pair_struct
+    {
+      K key;
+      V value;
+    };
+
+    Array<size_t> m_position;
+    Array<uint8_t> m_bucket;
+    std::array<std::vector<kv_pair_struct>, NUM_BUCKETS> m_buckets;
+    K m_last;
+    size_t m_size;
+
+
+    /**
+    * @brief Get the number of significant bits in a key.
+    *
+    * @param key The key.
+    *
+    * @return The number of bits up to and including the highest set bit.
+    */
+    static size_t significantBits(
+        K const key) noexcept
+    {
+      #if defined(__GNUC__) || defined(__clang__)
+      return key == 0 ? 0 : (sizeof(unsigned long long)*8) - \
+          static_cast<size_t>(__builtin_clzll( \
+              static_cast<unsigned long long>(key)));
+      #else
+      size_t bits = 0;
+      for (K k = key; k != 0; k >>= 1) {
+        ++bits;
+      }
+      return bits;
+      #endif
+    }
+
+
+    /**
+    * @brief Get the bucket for a given key, relative to the last key popped.
+    *
+    * @param key The key.
+    *
+    * @return The bucket index.
+    */
+    size_t bucketOf(
+        K const key) const noexcept
+    {
+      return significantBits(key ^ m_last);
+    }
+
+
+    /**
+    * @brief Append a key-value pair to a bucket.
+    *
+    * @param key The key.
+    * @param value The value.
+    * @param bucket The bucket.
+    */
+    void link(
+        K const key,
+        V const value,
+        size_t const bucket)
+    {
+      std::vector<kv_pair_struct> & pairs = m_buckets[bucket];
+      m_position[value] = pairs.size();
+      m_bucket[value] = static_cast<uint8_t>(bucket);
+      pairs.push_back(kv_pair_struct{key, value});
+    }
+
+
+    /**
+    * @brief Remove a value from its bucket, by moving the last pair of the
+    * bucket into its place.
+    *
+    * @param value The value.
+    */
+    void unlink(
+        V const value) noexcept
+    {
+      std::vector<kv_pair_struct> & pairs = m_buckets[m_bucket[value]];
+      size_t const position = m_position[value];
+
+      kv_pair_struct const last = pairs.back();
+      pairs[position] = last;
+      m_position[last.value] = position;
+      pairs.pop_back();
+    }
+
+
+    /**
+    * @brief Make the minimum key the last key popped, and move the pairs of
+    * the lowest non-empty bucket into the buckets below it. The pairs with
+    * the minimum key then make up the first bucket.
+    */
+    void redistribute()
+    {
+      size_t bucket = 1;
+      while (m_buckets[bucket].empty()) {
+        ++bucket;
+        ASSERT_LESS(bucket, NUM_BUCKETS);
+      }
+
+      std::vector<kv_pair_struct> & pairs = m_buckets[bucket];
+
+      K minKey = pairs[0].key;
+      for (kv_pair_struct const & pair : pairs) {
+        if (pair.key < minKey) {
+          minKey = pair.key;
+        }
+      }
+      m_last = minKey;
+
+      for (kv_pair_struct const & pair : pairs) {
+        link(pair.key, pair.value, bucketOf(pair.key));
+      }
+      pairs.clear();
+    }
+};
+
+
+template<typename K, typename V>
+constexpr size_t const RadixHeap<K, V>::NUM_BUCKETS;
+
+template<typename K, typename V>
+constexpr uint8_t const RadixHeap<K, V>::NO_BUCKET;
+
+
+}
+
+#endif
@@ -0,0 +1,371 @@
+/**
+* @file SetMath.hpp
+* @brief The SetMath class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-09
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef SOLIDUTILS_INCLUDE_SETMATH_HPP
+#define SOLIDUTILS_INCLUDE_SETMATH_HPP
+
+
+#include "Array.hpp"
+#include "ConstArray.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOLIDUTILS_SETMATH_SSE2 1
+#endif
+
+
+namespace sl
+{
+
+
+/**
+* @brief The SetMath class contains static functions for performing set
+* operations on sorted arrays of unique elements, such as the adjacency lists
+* of a graph.
+*/
+class SetMath
+{
+  public:
+    /**
+    * @brief When one array is this many times longer than the other, the
+    * intersection is found by galloping through the longer array rather than
+    * merging.
+    */
+    static constexpr size_t const GALLOP_RATIO = 32;
+
+    /**
+    * @brief Find the intersection of two sorted arrays of unique elements.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param b The second array.
+    * @param out The array to write the intersection to (must be at least the
+    * length of the shorter array).
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersect(
+        ConstArray<T> const & a,
+        ConstArray<T> const & b,
+        Array<T> & out) noexcept
+    {
+      ASSERT_GREATEREQUAL(out.size(), std::min(a.size(), b.size()));
+
+      return intersectDispatch(a.data(), a.size(), b.data(), b.size(), \
+          out.data());
+    }
+
+
+    /**
+    * @brief Count the number of elements in the intersection of two sorted
+    * arrays of unique elements.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param b The second array.
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectionSize(
+        ConstArray<T> const & a,
+        ConstArray<T> const & b) noexcept
+    {
+      return intersectDispatch<T>(a.data(), a.size(), b.data(), b.size(), \
+          nullptr);
+    }
+
+
+  private:
+    /**
+    * @brief Select the kernel to use based on the relative sizes of the
+    * arrays and the type of element.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param na The length of the first array.
+    * @param b The second array.
+    * @param nb The length of the second array.
+    * @param out The output array (may be null to only count).
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectDispatch(
+        T const * const a,
+        size_t const na,
+        T const * const b,
+        size_t const nb,
+        T * const out) noexcept
+    {
+      if (na * GALLOP_RATIO < nb) {
+        return intersectGallop(a, na, b, nb, out);
+      } else if (nb * GALLOP_RATIO < na) {
+        return intersectGallop(b, nb, a, na, out);
+      } else {
+        #ifdef SOLIDUTILS_SETMATH_SSE2
+        return intersectMerge(a, na, b, nb, out, std::integral_constant<bool, \
+            std::is_integral<T>::value && sizeof(T) == 4>());
+        #else
+        return intersectMerge(a, na, b, nb, out, std::false_type());
+        #endif
+      }
+    }
+
+
+    /**
+    * @brief Intersect by merging the two arrays.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param na The length of the first array.
+    * @param b The second array.
+    * @param nb The length of the second array.
+    * @param out The output array (may be null to only count).
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectMerge(
+        T const * const a,
+        size_t const na,
+        T const * const b,
+        size_t const nb,
+        T * const out,
+        std::false_type) noexcept
+    {
+      return intersectScalar(a, 0, na, b, 0, nb, out, 0);
+    }
+
+
+    #ifdef SOLIDUTILS_SETMATH_SSE2
+    /**
+    * @brief Intersect 32-bit integers by comparing blocks of four elements
+    * from each array against all four rotations of each other, and advancing
+    * the block with the smaller maximum.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param na The length of the first array.
+    * @param b The second array.
+    * @param nb The length of the second array.
+    * @param out The output array (may be null to only count).
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectMerge(
+        T const * const a,
+        size_t const na,
+        T const * const b,
+        size_t const nb,
+        T * const out,
+        std::true_type) noexcept
+    {
+      constexpr size_t const WIDTH = 4;
+
+      size_t const blockEndA = (na / WIDTH) * WIDTH;
+      size_t const blockEndB = (nb / WIDTH) * WIDTH;
+
+      size_t i = 0;
+      size_t j = 0;
+      size_t count = 0;
+
+      if (blockEndA > 0 && blockEndB > 0) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<__m128i const *>(b));
+        while (true) {
+          __m128i const cmp0 = _mm_cmpeq_epi32(va, vb);
+          __m128i const cmp1 = _mm_cmpeq_epi32(va, \
+              _mm_shuffle_epi32(vb, _MM_SHUFFLE(0,3,2,1)));
+          __m128i const cmp2 = _mm_cmpeq_epi32(va, \
+              _mm_shuffle_epi32(vb, _MM_SHUFFLE(1,0,3,2)));
+          __m128i const cmp3 = _mm_cmpeq_epi32(va, \
+              _mm_shuffle_epi32(vb, _MM_SHUFFLE(2,1,0,3)));
+          __m128i const cmp = _mm_or_si128(_mm_or_si128(cmp0, cmp1), \
+              _mm_or_si128(cmp2, cmp3));
+          int mask = _mm_movemask_ps(_mm_castsi128_ps(cmp));
+
+          // at most four matches, each marking a lane of va
+          while (mask != 0) {
+            if (out != nullptr) {
+              out[count] = a[i + lowestBit(mask)];
+            }
+            ++count;
+            mask &= mask - 1;
+          }
+
+          T const maxA = a[i+WIDTH-1];
+          T const maxB = b[j+WIDTH-1];
+          if (maxA <= maxB) {
+            i += WIDTH;
+            if (i == blockEndA) {
+              break;
+            }
+            va = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a+i));
+          }
+          if (maxB <= maxA) {
+            j += WIDTH;
+            if (j == blockEndB) {
+              break;
+            }
+            vb = _mm_loadu_si128(reinterpret_cast<__m128i const *>(b+j));
+          }
+        }
+      }
+
+      return intersectScalar(a, i, na, b, j, nb, out, count);
+    }
+
+
+    /**
+    * @brief Get the index of the lowest set bit.
+    *
+    * @param mask The non-zero mask.
+    *
+    * @return The index of the bit.
+    */
+    static inline int lowestBit(
+        int const mask) noexcept
+    {
+      #if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctz(static_cast<unsigned int>(mask));
+      #else
+      int bit = 0;
+      while (((mask >> bit) & 1) == 0) {
+        ++bit;
+      }
+      return bit;
+      #endif
+    }
+    #endif
+
+
+    /**
+    * @brief Intersect the remainder of two arrays by merging.
+    *
+    * @tparam T The type of element.
+    * @param a The first array.
+    * @param i The starting index in the first array.
+    * @param na The length of the first array.
+    * @param b The second array.
+    * @param j The starting index in the second array.
+    * @param nb The length of the second array.
+    * @param out The output array (may be null to only count).
+    * @param count The number of elements already found.
+    *
+    * @return The total number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectScalar(
+        T const * const a,
+        size_t i,
+        size_t const na,
+        T const * const b,
+        size_t j,
+        size_t const nb,
+        T * const out,
+        size_t count) noexcept
+    {
+      while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+          ++i;
+        } else if (b[j] < a[i]) {
+          ++j;
+        } else {
+          if (out != nullptr) {
+            out[count] = a[i];
+          }
+          ++count;
+          ++i;
+          ++j;
+        }
+      }
+
+      return count;
+    }
+
+
+    /**
+    * @brief Intersect a short array with a much longer one, by performing an
+    * exponential search in the long array for each element of the short
+    * array.
+    *
+    * @tparam T The type of element.
+    * @param small The short array.
+    * @param ns The length of the short array.
+    * @param large The long array.
+    * @param nl The length of the long array.
+    * @param out The output array (may be null to only count).
+    *
+    * @return The number of elements in the intersection.
+    */
+    template<typename T>
+    static size_t intersectGallop(
+        T const * const small,
+        size_t const ns,
+        T const * const large,
+        size_t const nl,
+        T * const out) noexcept
+    {
+      size_t count = 0;
+      size_t j = 0;
+      for (size_t i = 0; i < ns && j < nl; ++i) {
+        T const target = small[i];
+
+        // find a window [j+step/2, j+step] which contains the target
+        size_t step = 1;
+        while (j + step < nl && large[j + step] < target) {
+          step *= 2;
+        }
+        T const * const pos = std::lower_bound(large + j + (step / 2), \
+            large + std::min(j + step + 1, nl), target);
+        j = static_cast<size_t>(pos - large);
+
+        if (j < nl && !(target < large[j])) {
+          if (out != nullptr) {
+            out[count] = target;
+          }
+          ++count;
+          ++j;
+        }
+      }
+
+      return count;
+    }
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,271 @@
+/**
+* @file ShardedFixedMap.hpp
+* @brief The ShardedFixedMap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-16
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef SOLIDUTILS_INCLUDE_SHARDEDFIXEDMAP_HPP
+#define SOLIDUTILS_INCLUDE_SHARDEDFIXEDMAP_HPP
+
+
+#include "Array.hpp"
+#include "FixedMap.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace sl
+{
+
+/**
+* @brief The ShardedFixedMap class allows multiple threads to accumulate
+* values for keys in [0,size) without locking, and without each thread
+* allocating a structure the size of the key space. Each thread appends its
+* key-value pairs to its own buckets, one per range (shard) of keys, so
+* memory is proportional to the number of pairs added. The shards are then
+* reduced in parallel, with each shard's key range written by only one thread.
+*
+* ```
+* ShardedFixedMap<int, float> shards(n, numThreads);
+*
+* // on each thread
+* shards.add(threadId, key, value);
+*
+* // afterwards, on a single thread
+* Array<float> totals(n, 0);
+* shards.reduce(totals);
+* ```
+*
+* @tparam K The key type, must be an integer.
+* @tparam V The value type, must support `+=`.
+*/
+template <typename K, typename V>
+class ShardedFixedMap
+{
+  public:
+    /**
+    * @brief The default number of shards to create per thread. Having more
+    * shards than threads allows the reduction to be balanced when keys are
+    * not uniformly distributed.
+    */
+    static constexpr size_t const SHARDS_PER_THREAD = 4;
+
+    /**
+    * @brief Create a new empty sharded map.
+    *
+    * @param size The size of the key space.
+    * @param numThreads The number of threads that will add to the map, and
+    * that will perform the reduction.
+    * @param shardsPerThread The number of shards to create per thread.
+    */
+    ShardedFixedMap(
+        size_t const size,
+        size_t const numThreads,
+        size_t const shardsPerThread = SHARDS_PER_THREAD) :
+      m_size(size),
+      m_numThreads(std::max(numThreads, static_cast<size_t>(1))),
+      m_numShards(std::max(std::min(size, m_numThreads*shardsPerThread), \
+          static_cast<size_t>(1))),
+      m_shardSize(std::max((size + m_numShards - 1) / m_numShards, \
+          static_cast<size_t>(1))),
+      m_buckets(m_numThreads*m_numShards)
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Add a value to a key's total. This may be called concurrently
+    * by different threads, so long as each uses a different thread id.
+    *
+    * @param threadId The id of the calling thread.
+    * @param key The key.
+    * @param value The value to add.
+    */
+    void add(
+        size_t const threadId,
+        K const key,
+        V const value)
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(threadId, m_numThreads);
+      ASSERT_LESS(index, m_size);
+
+      m_buckets[bucketIndex(threadId, index / m_shardSize)].push_back( \
+          kv_pair_struct{key, value});
+    }
+
+
+    /**
+    * @brief Reduce the added values into a dense array, adding to its
+    * existing entries (i.e., `totals[key] += value`).
+    *
+    * @param totals The array of totals (must have at least size() entries).
+    */
+    void reduce(
+        Array<V> & totals) const
+    {
+      ASSERT_GREATEREQUAL(totals.size(), m_size);
+
+      V * const data = totals.data();
+      Parallel::forDynamic(m_numThreads, m_numShards, \
+          [this, data](size_t const shard, size_t) {
+        for (size_t t = 0; t < m_numThreads; ++t) {
+          for (kv_pair_struct const & pair : \
+              m_buckets[bucketIndex(t, shard)]) {
+            data[static_cast<size_t>(pair.key)] += pair.value;
+          }
+        }
+      });
+    }
+
+
+    /**
+    * @brief Reduce the added values into a map, adding to the values of keys
+    * already present. Totals are formed in parallel, and then inserted into
+    * the map in order of shard.
+    *
+    * @param map The map (must have a maximum size of at least size()).
+    */
+    void reduce(
+        FixedMap<K, V> & map) const
+    {
+      ASSERT_GREATEREQUAL(map.maxSize(), m_size);
+
+      Array<V> totals(m_size);
+      Array<bool> seen(m_size);
+      std::vector<std::vector<K>> touched(m_numShards);
+
+      Parallel::forDynamic(m_numThreads, m_numShards, \
+          [this, &totals, &seen, &touched](size_t const shard, size_t) {
+        size_t const start = std::min(shard*m_shardSize, m_size);
+        size_t const end = std::min(start+m_shardSize, m_size);
+        std::fill(seen.data()+start, seen.data()+end, false);
+
+        std::vector<K> & keys = touched[shard];
+        for (size_t t = 0; t < m_numThreads; ++t) {
+          for (kv_pair_struct const & pair : \
+              m_buckets[bucketIndex(t, shard)]) {
+            size_t const index = static_cast<size_t>(pair.key);
+            if (seen[index]) {
+              totals[index] += pair.value;
+            } else {
+              seen[index] = true;
+              totals[index] = pair.value;
+              keys.push_back(pair.key);
+            }
+          }
+        }
+      });
+
+      for (std::vector<K> const & keys : touched) {
+        for (K const key : keys) {
+          map.accumulate(key, totals[static_cast<size_t>(key)]);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Remove all added values. Bucket memory is retained for re-use.
+    */
+    void clear() noexcept
+    {
+      for (std::vector<kv_pair_struct> & bucket : m_buckets) {
+        bucket.clear();
+      }
+    }
+
+
+    /**
+    * @brief Get the size of the key space.
+    *
+    * @return The size.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Get the number of threads.
+    *
+    * @return The number of threads.
+    */
+    size_t numThreads() const noexcept
+    {
+      return m_numThreads;
+    }
+
+
+    /**
+    * @brief Get the number of shards the key space is divided into.
+    *
+    * @return The number of shards.
+    */
+    size_t numShards() const noexcept
+    {
+      return m_numShards;
+    }
+
+
+  private:
+    struct kv_pair_struct
+    {
+      K key;
+      V value;
+    };
+
+    size_t m_size;
+    size_t m_numThreads;
+    size_t m_numShards;
+    size_t m_shardSize;
+    std::vector<std::vector<kv_pair_struct>> m_buckets;
+
+
+    /**
+    * @brief Get the index of the bucket for a given thread and shard.
+    *
+    * @param threadId The thread.
+    * @param shard The shard.
+    *
+    * @return The bucket index.
+    */
+    size_t bucketIndex(
+        size_t const threadId,
+        size_t const shard) const noexcept
+    {
+      return (threadId*m_numShards) + shard;
+    }
+};
+
+}
+
+
+#endif
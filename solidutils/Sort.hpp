@@ -29,16 +29,109 @@
 #ifndef SOLIDUTILS_SORT_HPP
 #define SOLIDUTILS_SORT_HPP
 
+#include "Debug.hpp"
+#include "Parallel.hpp"
 #include "VectorMath.hpp"
 #include "Random.hpp"
+#include "SortingNetwork.hpp"
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <random>
+#include <type_traits>
 #include <vector>
 #include <algorithm>
 
 namespace sl
 {
 
+/**
+* @brief The FixedKeysWorkspace class holds the counts and output of
+* Sort::fixedKeysRange(), so that repeatedly sorting keys (e.g., bucketing
+* vertices at each level of a hierarchy) does not allocate once the
+* workspace has grown to the largest input. The permutation of the most
+* recent sort remains valid until the workspace is next used.
+*
+* @tparam I The index type (must be integral).
+*/
+template<typename I>
+class FixedKeysWorkspace
+{
+  public:
+    static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+    /**
+    * @brief Create a new empty workspace.
+    */
+    FixedKeysWorkspace() :
+      m_counts(),
+      m_wideCounts(),
+      m_out(),
+      m_capacity(0)
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Grow the workspace to sort a given number of keys in [0,maxKey]
+    * without allocating.
+    *
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    */
+    void reserve(
+        size_t const num,
+        size_t const maxKey)
+    {
+      if (num <= UINT32_MAX) {
+        m_counts.reserve(maxKey+1);
+      } else {
+        m_wideCounts.reserve(maxKey+1);
+      }
+      if (num > m_capacity) {
+        m_out.reset(new I[num]);
+        m_capacity = num;
+      }
+    }
+
+
+    /**
+    * @brief Get the permutation of the most recent sort.
+    *
+    * @return The permutation.
+    */
+    I * permutation() noexcept
+    {
+      return m_out.get();
+    }
+
+
+    /**
+    * @brief Get the permutation of the most recent sort.
+    *
+    * @return The permutation.
+    */
+    I const * permutation() const noexcept
+    {
+      return m_out.get();
+    }
+
+
+  private:
+    friend class Sort;
+
+    std::vector<uint32_t> m_counts;
+    std::vector<size_t> m_wideCounts;
+    std::unique_ptr<I[]> m_out;
+    size_t m_capacity;
+};
+
+
 class Sort
 {
   public:
@@ -57,37 +150,236 @@ class Sort
     static std::unique_ptr<I[]> fixedKeys(
         K const * const keys,
         size_t const num)
+    {
+      return fixedKeysRange<K, I>(keys, num, num);
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys in [0,maxKey],
+    * where the maximum key need not be related to the number of keys. Small
+    * key ranges (e.g., partition IDs) use correspondingly small counts, and
+    * keys may exceed the number of keys. The counts are 32-bit when the
+    * number of keys allows it.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I>
+    static std::unique_ptr<I[]> fixedKeysRange(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey)
     {
       static_assert(std::is_integral<K>::value, "Must by integral type.");
       static_assert(std::is_integral<I>::value, "Must by integral type.");
 
-      std::vector<size_t> counts(num+1,0);
-      counts.reserve(num);
+      std::unique_ptr<I[]> out(new I[num]);
+      if (num <= UINT32_MAX) {
+        std::vector<uint32_t> counts;
+        countingSort(keys, num, maxKey, counts, out.get());
+      } else {
+        std::vector<size_t> counts;
+        countingSort(keys, num, maxKey, counts, out.get());
+      }
+
+      return out;
+    }
+
 
-      /* avoid having to do offsets in each iteration */
-      for (size_t i = 0; i < num; ++i) {
-        ++counts[keys[i]];
+    /**
+    * @brief Generate a permutation for a given set of keys in [0,maxKey],
+    * using the counts and output of a workspace, so that no memory is
+    * allocated once the workspace is large enough. The counts are 32-bit
+    * when the number of keys allows it.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    * @param workspace The workspace.
+    *
+    * @return The sorted permutation array, owned by the workspace.
+    */
+    template<typename K, typename I>
+    static I * fixedKeysRange(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey,
+        FixedKeysWorkspace<I> & workspace)
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+
+      workspace.reserve(num, maxKey);
+      if (num <= UINT32_MAX) {
+        countingSort(keys, num, maxKey, workspace.m_counts, \
+            workspace.m_out.get());
+      } else {
+        countingSort(keys, num, maxKey, workspace.m_wideCounts, \
+            workspace.m_out.get());
       }
 
-      sl::VectorMath::prefixSumExclusive(counts.data(), counts.size());
+      return workspace.m_out.get();
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys, with the indices
+    * of equal keys randomly ordered. The range of the keys must be limited
+    * to [0,n), where n is the number of keys.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param rng The random source.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I, typename URBG>
+    static std::unique_ptr<I[]> fixedKeysRandom(
+        K const * const keys,
+        size_t const num,
+        URBG&& rng)
+    {
+      return fixedKeysRandomRange<K, I>(keys, num, num, rng);
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys in [0,maxKey],
+    * with the indices of equal keys randomly ordered. The counts are 32-bit
+    * when the number of keys allows it.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    * @param rng The random source.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I, typename URBG>
+    static std::unique_ptr<I[]> fixedKeysRandomRange(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey,
+        URBG&& rng)
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
 
       std::unique_ptr<I[]> out(new I[num]);
+      if (num <= UINT32_MAX) {
+        std::vector<uint32_t> counts;
+        countingSort(keys, num, maxKey, counts, out.get());
+        shuffleBuckets(counts.data(), num, out.get(), rng);
+      } else {
+        std::vector<size_t> counts;
+        countingSort(keys, num, maxKey, counts, out.get());
+        shuffleBuckets(counts.data(), num, out.get(), rng);
+      }
 
-      for (size_t i = 0; i < num; ++i) {
-        out[counts[keys[i]]++] = i;
+      return out;
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys in parallel. The
+    * range of the keys must be limited to [0,n), where n is the number of
+    * keys. The permutation is the same as that of the serial version (the
+    * sort is stable).
+    *
+    * Rather than each thread keeping a histogram of all n keys, the keys are
+    * first partitioned by their high bits into a number of ranges using
+    * per-thread histograms, and then each range is counting sorted by a
+    * single thread. This requires O(n) additional memory independent of the
+    * number of threads.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param numThreads The number of threads to use.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I>
+    static std::unique_ptr<I[]> fixedKeys(
+        K const * const keys,
+        size_t const num,
+        size_t const numThreads)
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+      if (numThreads <= 1) {
+        return fixedKeys<K, I>(keys, num);
       }
 
+      std::unique_ptr<I[]> out(new I[num]);
+      fixedKeysParallel(keys, num, num, numThreads, out.get(), \
+          static_cast<uint32_t const *>(nullptr));
+
       return out;
     }
 
+
     /**
-    * @brief Generate a permutation for a given set of keys. The range of the
-    * keys must be limited to [0,n), where n is the number of keys.
+    * @brief Generate a permutation for a given set of keys in [0,maxKey] in
+    * parallel. The permutation is the same as that of the serial version
+    * (the sort is stable).
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    * @param numThreads The number of threads to use.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I>
+    static std::unique_ptr<I[]> fixedKeysRange(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey,
+        size_t const numThreads)
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+      if (numThreads <= 1) {
+        return fixedKeysRange<K, I>(keys, num, maxKey);
+      }
+
+      std::unique_ptr<I[]> out(new I[num]);
+      fixedKeysParallel(keys, num, maxKey+1, numThreads, out.get(), \
+          static_cast<uint32_t const *>(nullptr));
+
+      return out;
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys in parallel, with
+    * the indices of equal keys randomly ordered. The range of the keys must
+    * be limited to [0,n), where n is the number of keys. For a given random
+    * source and number of threads, the permutation is deterministic.
     *
     * @tparam K The key type (must be integral).
     * @tparam I The index type (must be integral).
     * @param keys The set of keys to use to generate the sorted permutation.
     * @param num The number of keys.
+    * @param rng The random source.
+    * @param numThreads The number of threads to use.
     *
     * @return The sorted permutation array.
     */
@@ -95,38 +387,1861 @@ class Sort
     static std::unique_ptr<I[]> fixedKeysRandom(
         K const * const keys,
         size_t const num,
-        URBG&& rng)
+        URBG&& rng,
+        size_t const numThreads)
     {
       static_assert(std::is_integral<K>::value, "Must by integral type.");
       static_assert(std::is_integral<I>::value, "Must by integral type.");
 
-      std::vector<size_t> counts(num+1,0);
-      counts.reserve(num);
-
-      /* avoid having to do offsets in each iteration */
-      for (size_t i = 0; i < num; ++i) {
-        ++counts[keys[i]];
+      if (numThreads <= 1) {
+        return fixedKeysRandom<K, I>(keys, num, rng);
       }
 
-      sl::VectorMath::prefixSumExclusive(counts.data(), counts.size());
+      // seed each range from the given source, so the result does not
+      // depend on which thread sorts which range
+      std::vector<uint32_t> seeds(numRanges(num, numThreads));
+      for (uint32_t & seed : seeds) {
+        seed = static_cast<uint32_t>(rng());
+      }
 
       std::unique_ptr<I[]> out(new I[num]);
+      fixedKeysParallel(keys, num, num, numThreads, out.get(), seeds.data());
 
-      for (size_t i = 0; i < num; ++i) {
-        out[counts[keys[i]]++] = i;
+      return out;
+    }
+
+
+    /**
+    * @brief Generate a permutation for a given set of keys in [0,maxKey] in
+    * parallel, with the indices of equal keys randomly ordered. For a given
+    * random source and number of threads, the permutation is deterministic.
+    *
+    * @tparam K The key type (must be integral).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    * @param rng The random source.
+    * @param numThreads The number of threads to use.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I, typename URBG>
+    static std::unique_ptr<I[]> fixedKeysRandomRange(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey,
+        URBG&& rng,
+        size_t const numThreads)
+    {
+      static_assert(std::is_integral<K>::value, "Must by integral type.");
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+      if (numThreads <= 1) {
+        return fixedKeysRandomRange<K, I>(keys, num, maxKey, rng);
       }
 
-      // randomize each bucket
-      size_t start = 0;
-      for (size_t i = 0; start < num; ++i) {
-        sl::Random::pseudoShuffle(out.get()+start, counts[i] - start, rng);
-        start = counts[i];
+      std::vector<uint32_t> seeds(numRanges(maxKey+1, numThreads));
+      for (uint32_t & seed : seeds) {
+        seed = static_cast<uint32_t>(rng());
       }
 
+      std::unique_ptr<I[]> out(new I[num]);
+      fixedKeysParallel(keys, num, maxKey+1, numThreads, out.get(), \
+          seeds.data());
+
+      return out;
+    }
+
+
+    /**
+    * @brief Sort a set of integer keys in place, using an LSD radix sort.
+    * The histograms of every digit are built in a single pass over the keys,
+    * and passes where all keys share the same digit are skipped, so keys
+    * occupying a small range need few passes. Signed keys are supported.
+    * The sort runs in O(num * sizeof(K)*8 / BITS) time.
+    *
+    * Floating point keys (float and double) are sorted by the order
+    * preserving transform of their bits (flipping the sign bit of positive
+    * keys, and all bits of negative keys), so -0.0 precedes 0.0. NaNs, of
+    * either sign, are placed after all other keys in their original order.
+    *
+    * With multiple threads, each pass is performed by counting the digits of
+    * each thread's block of keys, and scattering each block to offsets
+    * prefix summed in (digit, thread) order, which keeps the sort stable.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam BITS The number of bits per digit, at most 11 (8 or 11 are
+    * typical, the latter needing fewer passes of a larger histogram).
+    * @param keys The keys to sort.
+    * @param num The number of keys.
+    * @param scratch Scratch memory of at least num elements.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, size_t BITS = 8>
+    static void radix(
+        K * const keys,
+        size_t const num,
+        K * const scratch,
+        size_t const numThreads = 1)
+    {
+      radixSort<K, size_t, BITS, Payload::NONE>(keys, nullptr, num, scratch, \
+          nullptr, numThreads);
+    }
+
+
+    /**
+    * @brief Sort a set of integer keys in place using an LSD radix sort (see
+    * above), and generate the sorted permutation, such that `index[i]` is the
+    * original position of the key now at position i. The sort is stable.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam I The index type (must be integral).
+    * @tparam BITS The number of bits per digit.
+    * @param keys The keys to sort.
+    * @param index The permutation to generate (output, at least num
+    * elements).
+    * @param num The number of keys.
+    * @param keyScratch Scratch memory of at least num keys.
+    * @param indexScratch Scratch memory of at least num indices.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename I, size_t BITS = 8>
+    static void radix(
+        K * const keys,
+        I * const index,
+        size_t const num,
+        K * const keyScratch,
+        I * const indexScratch,
+        size_t const numThreads = 1)
+    {
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+      radixSort<K, I, BITS, Payload::INDEX>(keys, index, num, keyScratch, \
+          indexScratch, numThreads);
+    }
+
+
+    /**
+    * @brief Sort a set of key-value pairs by key in place using an LSD radix
+    * sort (see above), moving each value with its key. This avoids
+    * generating a permutation and then gathering the values through it. The
+    * sort is stable. To carry several payloads (e.g., the destination and
+    * weight of an edge), use a struct as the value type.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam V The value type.
+    * @tparam BITS The number of bits per digit.
+    * @param keys The keys to sort.
+    * @param values The values to sort along with the keys.
+    * @param num The number of pairs.
+    * @param keyScratch Scratch memory of at least num keys.
+    * @param valueScratch Scratch memory of at least num values.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename V, size_t BITS = 8>
+    static void radixByKey(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        K * const keyScratch,
+        V * const valueScratch,
+        size_t const numThreads = 1)
+    {
+      radixSort<K, V, BITS, Payload::CARRY>(keys, values, num, keyScratch, \
+          valueScratch, numThreads);
+    }
+
+
+    /**
+    * @brief Generate the sorted permutation of a set of keys using an LSD
+    * radix sort, leaving the keys unmodified. Unlike fixedKeys(), the keys
+    * may span any range, and may be floating point (see radix() for the
+    * ordering of floating point keys). The permutation is stable.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam I The index type (must be integral).
+    * @param keys The set of keys to use to generate the sorted permutation.
+    * @param num The number of keys.
+    * @param numThreads The number of threads to use.
+    *
+    * @return The sorted permutation array.
+    */
+    template<typename K, typename I>
+    static std::unique_ptr<I[]> radixPermutation(
+        K const * const keys,
+        size_t const num,
+        size_t const numThreads = 1)
+    {
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+
+      std::vector<K> sorted(keys, keys+num);
+      std::vector<K> keyScratch(num);
+      std::vector<I> indexScratch(num);
+      std::unique_ptr<I[]> out(new I[num]);
+
+      radixSort<K, I, 8, Payload::INDEX>(sorted.data(), out.get(), num, \
+          keyScratch.data(), indexScratch.data(), numThreads);
+
       return out;
     }
 
 
+    /**
+    * @brief Sort a set of keys in place using an MSD (American flag) radix
+    * sort, needing only O(radix) extra memory per recursion level, rather
+    * than the scratch array of radix(). Each level counts the keys' digits
+    * and permutes them into buckets by following cycles, and buckets of at
+    * most INPLACE_INSERTION_SIZE keys are insertion sorted. The sort is not
+    * stable. Keys are ordered as for radix() (including floating point
+    * keys).
+    *
+    * With multiple threads, the top level's digits are counted in parallel,
+    * its permutation is performed serially, and the buckets are then sorted
+    * in parallel, largest first. This needs O(radix * numThreads) extra
+    * memory.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @param keys The keys to sort.
+    * @param num The number of keys.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K>
+    static void inPlaceRadix(
+        K * const keys,
+        size_t const num,
+        size_t const numThreads = 1)
+    {
+      inPlaceRadixSort<K, K, false>(keys, nullptr, num, numThreads);
+    }
+
+
+    /**
+    * @brief Sort a set of key-value pairs by key in place using an MSD radix
+    * sort (see above), moving each value with its key.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam V The value type.
+    * @param keys The keys to sort.
+    * @param values The values to sort along with the keys.
+    * @param num The number of pairs.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename V>
+    static void inPlaceRadixByKey(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        size_t const numThreads = 1)
+    {
+      inPlaceRadixSort<K, V, true>(keys, values, num, numThreads);
+    }
+
+
+    /**
+    * @brief Rearrange an array such that the element at position k is the
+    * one which would be there if the array were sorted, with no element
+    * before it greater and no element after it less (as std::nth_element).
+    * This uses the Floyd-Rivest algorithm, which partitions around a pivot
+    * chosen by recursively selecting from a sample, and falls back to
+    * std::nth_element if it fails to converge.
+    *
+    * @tparam T The type of element.
+    * @tparam C The comparator type.
+    * @param data The array.
+    * @param num The number of elements.
+    * @param k The position to select (less than num).
+    * @param compare The comparator.
+    *
+    * @return The selected element.
+    */
+    template<typename T, typename C = std::less<T>>
+    static T select(
+        T * const data,
+        size_t const num,
+        size_t const k,
+        C const & compare = C())
+    {
+      ASSERT_LESS(k, num);
+
+      ptrdiff_t const last = static_cast<ptrdiff_t>(num) - 1;
+      floydRivest(data, 0, last, static_cast<ptrdiff_t>(k), compare, \
+          4 * floorLog2(num) + 8);
+
+      return data[k];
+    }
+
+
+    /**
+    * @brief Find the key which would be at position k if the keys were
+    * sorted by radix() (i.e., the k-th smallest), without modifying them.
+    * The keys are histogrammed one 8-bit digit at a time, from the most
+    * significant, counting only keys matching the digits already chosen,
+    * until the keys in the chosen bucket are few enough (an eighth of the
+    * keys) to copy out and finish with select(). With multiple threads, the
+    * histograms and the copy are performed in parallel.
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @param keys The keys.
+    * @param num The number of keys.
+    * @param k The position to select (less than num).
+    * @param numThreads The number of threads to use.
+    *
+    * @return The selected key.
+    */
+    template<typename K>
+    static K selectKey(
+        K const * const keys,
+        size_t const num,
+        size_t const k,
+        size_t const numThreads = 1)
+    {
+      static_assert(RadixKey<K>::SUPPORTED, \
+          "Must by integral, float, or double type.");
+      ASSERT_LESS(k, num);
+
+      using U = typename RadixKey<K>::type;
+
+      constexpr size_t const RADIX = static_cast<size_t>(1) << INPLACE_BITS;
+      constexpr size_t const KEY_BITS = sizeof(K)*8;
+
+      size_t const threads = std::max(static_cast<size_t>(1), \
+          std::min(numThreads, num / RADIX));
+
+      std::vector<size_t> threadCounts(threads*RADIX);
+      U prefix = 0;
+      size_t rank = k;
+      for (size_t shift = KEY_BITS - INPLACE_BITS; ; \
+          shift -= INPLACE_BITS) {
+        // only keys matching the digits above this one are counted
+        U const mask = shift + INPLACE_BITS < KEY_BITS ? \
+            static_cast<U>(static_cast<U>(~static_cast<U>(0)) << \
+            (shift + INPLACE_BITS)) : \
+            static_cast<U>(0);
+        Parallel::run(threads, [&](size_t const t) {
+          size_t * const counts = threadCounts.data() + (t*RADIX);
+          std::fill(counts, counts+RADIX, 0);
+          size_t const end = Parallel::blockStart(num, t+1, threads);
+          for (size_t i = Parallel::blockStart(num, t, threads); i < end; \
+              ++i) {
+            U const bits = radixBits(keys[i]);
+            if ((bits & mask) == prefix) {
+              ++counts[(bits >> shift) & (RADIX-1)];
+            }
+          }
+        });
+
+        size_t digit = 0;
+        size_t count = 0;
+        while (true) {
+          count = 0;
+          for (size_t t = 0; t < threads; ++t) {
+            count += threadCounts[(t*RADIX) + digit];
+          }
+          if (rank < count) {
+            break;
+          }
+          rank -= count;
+          ++digit;
+        }
+        prefix = static_cast<U>(prefix | (static_cast<U>(digit) << shift));
+
+        if (shift == 0 || count <= num / 8) {
+          // copy out the keys of the bucket, each thread into the positions
+          // its counts give it
+          U const bucketMask = static_cast<U>( \
+              static_cast<U>(~static_cast<U>(0)) << shift);
+          std::vector<size_t> offsets(threads+1, 0);
+          for (size_t t = 0; t < threads; ++t) {
+            offsets[t+1] = offsets[t] + threadCounts[(t*RADIX) + digit];
+          }
+          std::vector<U> bucket(count);
+          Parallel::run(threads, [&](size_t const t) {
+            size_t pos = offsets[t];
+            size_t const end = Parallel::blockStart(num, t+1, threads);
+            for (size_t i = Parallel::blockStart(num, t, threads); i < end; \
+                ++i) {
+              U const bits = radixBits(keys[i]);
+              if ((bits & bucketMask) == prefix) {
+                bucket[pos++] = bits;
+              }
+            }
+          });
+
+          U const bits = select(bucket.data(), count, rank);
+
+          // return a key with those bits (there may be multiple NaNs)
+          for (size_t i = 0; ; ++i) {
+            if (radixBits(keys[i]) == bits) {
+              return keys[i];
+            }
+          }
+        }
+      }
+    }
+
+
+    /**
+    * @brief Find the positions of the k largest keys (in the order of
+    * radix()), without sorting all of the keys. The k-th largest key is
+    * found with selectKey(), and the keys greater than it and the first
+    * keys equal to it are gathered (in parallel with multiple threads).
+    *
+    * @tparam K The key type (must be integral, float, or double).
+    * @tparam I The index type (must be integral).
+    * @param keys The keys.
+    * @param num The number of keys.
+    * @param k The number of keys to find (at most num).
+    * @param numThreads The number of threads to use.
+    *
+    * @return The positions of the k largest keys, from largest to smallest,
+    * with equal keys in order of position.
+    */
+    template<typename K, typename I>
+    static std::unique_ptr<I[]> partialTopK(
+        K const * const keys,
+        size_t const num,
+        size_t const k,
+        size_t const numThreads = 1)
+    {
+      static_assert(std::is_integral<I>::value, "Must by integral type.");
+      ASSERT_LESSEQUAL(k, num);
+
+      using U = typename RadixKey<K>::type;
+
+      std::unique_ptr<I[]> out(new I[k]);
+      if (k == 0) {
+        return out;
+      }
+
+      U const threshold = radixBits(selectKey(keys, num, num - k, \
+          numThreads));
+
+      // each thread gathers the keys above the threshold, and up to k equal
+      // to it, from its block
+      size_t const threads = std::max(static_cast<size_t>(1), \
+          std::min(numThreads, num >> INPLACE_BITS));
+      std::vector<std::vector<I>> above(threads);
+      std::vector<std::vector<I>> equal(threads);
+      Parallel::run(threads, [&](size_t const t) {
+        size_t const end = Parallel::blockStart(num, t+1, threads);
+        for (size_t i = Parallel::blockStart(num, t, threads); i < end; ++i) {
+          U const bits = radixBits(keys[i]);
+          if (bits > threshold) {
+            above[t].push_back(static_cast<I>(i));
+          } else if (bits == threshold && equal[t].size() < k) {
+            equal[t].push_back(static_cast<I>(i));
+          }
+        }
+      });
+
+      size_t pos = 0;
+      for (std::vector<I> const & indices : above) {
+        std::copy(indices.begin(), indices.end(), out.get() + pos);
+        pos += indices.size();
+      }
+      for (size_t t = 0; t < threads && pos < k; ++t) {
+        size_t const take = std::min(equal[t].size(), k - pos);
+        std::copy(equal[t].begin(), equal[t].begin() + take, out.get() + pos);
+        pos += take;
+      }
+      ASSERT_EQUAL(pos, k);
+
+      std::sort(out.get(), out.get() + k, [keys](I const a, I const b) {
+        U const bitsA = radixBits(keys[a]);
+        U const bitsB = radixBits(keys[b]);
+        return bitsA > bitsB || (bitsA == bitsB && a < b);
+      });
+
+      return out;
+    }
+
+
+    /**
+    * @brief Sort an array of any comparable type in parallel, using a
+    * sample sort. Splitters are chosen from a sorted random sample
+    * (oversampled to balance the buckets), each thread classifies its block
+    * of elements into the buckets between splitters, the elements are
+    * scattered to their buckets in parallel, and the buckets are sorted
+    * with std::sort, claimed dynamically. Elements equal to a splitter go
+    * to a bucket of their own which needs no sorting, so heavily
+    * duplicated keys do not unbalance the buckets. With one thread, or few
+    * elements per thread, this is std::sort. The sort is not stable.
+    *
+    * @tparam T The type of element (must be copy assignable and default
+    * constructible).
+    * @tparam C The comparator type.
+    * @param data The array.
+    * @param num The number of elements.
+    * @param numThreads The number of threads to use.
+    * @param compare The comparator.
+    */
+    template<typename T, typename C = std::less<T>>
+    static void sample(
+        T * const data,
+        size_t const num,
+        size_t const numThreads,
+        C const & compare = C())
+    {
+      size_t const threads = std::min(numThreads, \
+          num / SAMPLE_MIN_PER_THREAD);
+      if (threads <= 1) {
+        std::sort(data, data+num, compare);
+        return;
+      }
+
+      // choose the splitters from a sorted random sample
+      size_t const numSplitters = std::min(threads*SAMPLE_BUCKETS_PER_THREAD, \
+          static_cast<size_t>(UINT16_MAX / 2)) - 1;
+      std::vector<T> splitters((numSplitters+1) * SAMPLE_OVERSAMPLING);
+      std::mt19937 rng(static_cast<uint32_t>(num));
+      std::uniform_int_distribution<size_t> dist(0, num-1);
+      for (T & splitter : splitters) {
+        splitter = data[dist(rng)];
+      }
+      std::sort(splitters.begin(), splitters.end(), compare);
+      for (size_t i = 0; i < numSplitters; ++i) {
+        splitters[i] = splitters[(i+1)*SAMPLE_OVERSAMPLING];
+      }
+      splitters.resize(numSplitters);
+
+      // classify each thread's block, with bucket 2i+1 holding the elements
+      // equal to splitter i
+      size_t const numBuckets = (2*numSplitters) + 1;
+      std::vector<uint16_t> bucketOf(num);
+      std::vector<size_t> counts(threads*numBuckets, 0);
+      Parallel::run(threads, [&](size_t const t) {
+        size_t * const local = counts.data() + (t*numBuckets);
+        size_t const end = Parallel::blockStart(num, t+1, threads);
+        for (size_t i = Parallel::blockStart(num, t, threads); i < end; ++i) {
+          size_t const j = static_cast<size_t>(std::upper_bound( \
+              splitters.begin(), splitters.end(), data[i], compare) - \
+              splitters.begin());
+          size_t const bucket = (j > 0 && !compare(splitters[j-1], data[i])) \
+              ? (2*j) - 1 : 2*j;
+          bucketOf[i] = static_cast<uint16_t>(bucket);
+          ++local[bucket];
+        }
+      });
+
+      // offsets in (bucket, thread) order
+      std::vector<size_t> bucketStarts(numBuckets+1);
+      size_t offset = 0;
+      for (size_t b = 0; b < numBuckets; ++b) {
+        bucketStarts[b] = offset;
+        for (size_t t = 0; t < threads; ++t) {
+          size_t & count = counts[(t*numBuckets) + b];
+          size_t const c = count;
+          count = offset;
+          offset += c;
+        }
+      }
+      bucketStarts[numBuckets] = offset;
+
+      std::unique_ptr<T[]> scratch(new T[num]);
+      Parallel::run(threads, [&](size_t const t) {
+        size_t * const local = counts.data() + (t*numBuckets);
+        size_t const end = Parallel::blockStart(num, t+1, threads);
+        for (size_t i = Parallel::blockStart(num, t, threads); i < end; ++i) {
+          scratch[local[bucketOf[i]]++] = data[i];
+        }
+      });
+
+      Parallel::forDynamic(threads, numBuckets, \
+          [&](size_t const b, size_t) {
+        T * const start = scratch.get() + bucketStarts[b];
+        T * const end = scratch.get() + bucketStarts[b+1];
+        if (b % 2 == 0) {
+          std::sort(start, end, compare);
+        }
+        std::copy(start, end, data + bucketStarts[b]);
+      });
+    }
+
+
+    /**
+    * @brief Sort a short array (e.g., an adjacency list) in place, using
+    * sorting networks and in-register merges when AVX2 is available, and
+    * std::sort otherwise. The sort is not stable. See SortingNetwork.
+    *
+    * @tparam T The type of element (must be arithmetic).
+    * @param data The array.
+    * @param num The number of elements (ideally at most
+    * SortingNetwork::MAX_SIZE).
+    */
+    template<typename T>
+    static void small(
+        T * const data,
+        size_t const num) noexcept
+    {
+      SortingNetwork::sort(data, num);
+    }
+
+
+    /**
+    * @brief Sort a short array of keys in place, keeping an array of values
+    * in sync with them (see above). Keys and values of 32-bits use the
+    * vectorized path.
+    *
+    * @tparam K The key type (must be arithmetic).
+    * @tparam V The value type (must be arithmetic).
+    * @param keys The keys.
+    * @param values The values.
+    * @param num The number of pairs (ideally at most
+    * SortingNetwork::MAX_SIZE).
+    */
+    template<typename K, typename V>
+    static void small(
+        K * const keys,
+        V * const values,
+        size_t const num)
+    {
+      SortingNetwork::sort(keys, values, num);
+    }
+
+
+    /**
+    * @brief Sort each segment of an array independently, such as the
+    * adjacency lists of a CSR graph. Segments are binned by length: runs of
+    * consecutive short segments (at most SortingNetwork::MAX_SIZE) are
+    * sorted with Sort::small(), and longer segments with a radix sort (or
+    * std::sort for long double keys). Segments long enough to
+    * unbalance the threads are radix sorted one at a time using all
+    * threads, and the rest are claimed dynamically, longest first. The sort
+    * is not stable.
+    *
+    * ```
+    * Sort::segmented(xadj, numVertices, adjncy, numThreads);
+    * ```
+    *
+    * @tparam O The offset type (must be integral).
+    * @tparam K The key type (must be arithmetic).
+    * @param offsets The start of each segment, with `offsets[numSegments]`
+    * marking the end of the last.
+    * @param numSegments The number of segments.
+    * @param keys The keys to sort.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename O, typename K>
+    static void segmented(
+        O const * const offsets,
+        size_t const numSegments,
+        K * const keys,
+        size_t const numThreads = 1)
+    {
+      segmentedSort<O, K, K, false>(offsets, numSegments, keys, nullptr, \
+          numThreads);
+    }
+
+
+    /**
+    * @brief Sort each segment of an array of keys independently, keeping an
+    * array of values (e.g., edge weights) in sync with them (see above).
+    *
+    * @tparam O The offset type (must be integral).
+    * @tparam K The key type (must be arithmetic).
+    * @tparam V The value type (must be arithmetic).
+    * @param offsets The start of each segment, with `offsets[numSegments]`
+    * marking the end of the last.
+    * @param numSegments The number of segments.
+    * @param keys The keys to sort.
+    * @param values The values to keep in sync.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename O, typename K, typename V>
+    static void segmented(
+        O const * const offsets,
+        size_t const numSegments,
+        K * const keys,
+        V * const values,
+        size_t const numThreads = 1)
+    {
+      segmentedSort<O, K, V, true>(offsets, numSegments, keys, values, \
+          numThreads);
+    }
+
+
+  private:
+    /**
+    * @brief The minimum number of elements per thread for the sample sort
+    * to use multiple threads.
+    */
+    static constexpr size_t const SAMPLE_MIN_PER_THREAD = 4096;
+
+    /**
+    * @brief The number of buckets per thread of the sample sort.
+    */
+    static constexpr size_t const SAMPLE_BUCKETS_PER_THREAD = 8;
+
+    /**
+    * @brief The number of samples taken per splitter by the sample sort.
+    */
+    static constexpr size_t const SAMPLE_OVERSAMPLING = 16;
+
+    /**
+    * @brief The number of bits per digit of the in-place radix sort.
+    */
+    static constexpr size_t const INPLACE_BITS = 8;
+
+    /**
+    * @brief Buckets of at most this size are insertion sorted by the
+    * in-place radix sort.
+    */
+    static constexpr size_t const INPLACE_INSERTION_SIZE = 32;
+
+    /**
+    * @brief The unsigned type a key is radix sorted as.
+    *
+    * @tparam K The key type.
+    */
+    template<typename K, bool FLOAT = std::is_floating_point<K>::value>
+    struct RadixKey
+    {
+      static constexpr bool const SUPPORTED = std::is_integral<K>::value;
+      using type = typename std::make_unsigned<K>::type;
+    };
+
+    template<typename K>
+    struct RadixKey<K, true>
+    {
+      static constexpr bool const SUPPORTED = sizeof(K) == sizeof(uint32_t) \
+          || sizeof(K) == sizeof(uint64_t);
+      using type = typename std::conditional<sizeof(K) == sizeof(uint32_t), \
+          uint32_t, uint64_t>::type;
+    };
+
+    /**
+    * @brief The number of elements of short segments grouped into a single
+    * task when sorting segments.
+    */
+    static constexpr size_t const SEGMENT_CHUNK_SIZE = 16384;
+
+    /**
+    * @brief How the payload of a radix sort is treated.
+    */
+    struct Payload
+    {
+      static constexpr int const NONE = 0;
+      static constexpr int const CARRY = 1;
+      static constexpr int const INDEX = 2;
+    };
+
+    /**
+    * @brief The number of key ranges per thread to partition keys into when
+    * sorting in parallel.
+    */
+    static constexpr size_t const RANGES_PER_THREAD = 64;
+
+    /**
+    * @brief Get the number of bits to shift a key by to find its range when
+    * sorting in parallel.
+    *
+    * @param num The number of keys (and bound on the keys).
+    * @param numThreads The number of threads.
+    *
+    * @return The number of bits.
+    */
+    static size_t rangeShift(
+        size_t const num,
+        size_t const numThreads) noexcept
+    {
+      size_t const target = numThreads * RANGES_PER_THREAD;
+
+      size_t shift = 0;
+      while (num > 0 && ((num - 1) >> shift) >= target) {
+        ++shift;
+      }
+
+      return shift;
+    }
+
+
+    /**
+    * @brief Get the number of key ranges used when sorting in parallel.
+    *
+    * @param num The number of keys (and bound on the keys).
+    * @param numThreads The number of threads.
+    *
+    * @return The number of ranges.
+    */
+    static size_t numRanges(
+        size_t const num,
+        size_t const numThreads) noexcept
+    {
+      return num > 0 ? ((num - 1) >> rangeShift(num, numThreads)) + 1 : 0;
+    }
+
+
+    /**
+    * @brief Generate the sorted permutation of keys in [0,range) in
+    * parallel.
+    * First, each thread counts the ranges of the keys in its block, and the
+    * (range, thread) pairs are prefix summed, so that each thread can
+    * scatter its keys and their indices grouped by range while preserving
+    * their order. Then each range is counting sorted by a single thread, and
+    * optionally the indices of each key shuffled.
+    *
+    * @tparam K The key type.
+    * @tparam I The index type.
+    * @param keys The keys.
+    * @param num The number of keys.
+    * @param range The number of possible keys (all keys are less than it).
+    * @param numThreads The number of threads to use.
+    * @param out The permutation (output).
+    * @param seeds The random seed for each range, or null to not shuffle.
+    */
+    template<typename K, typename I>
+    static void fixedKeysParallel(
+        K const * const keys,
+        size_t const num,
+        size_t const range,
+        size_t const numThreads,
+        I * const out,
+        uint32_t const * const seeds)
+    {
+      size_t const shift = rangeShift(range, numThreads);
+      size_t const ranges = numRanges(range, numThreads);
+
+      // counts of each range in each thread's block
+      std::vector<size_t> counts(ranges*numThreads, 0);
+      Parallel::run(numThreads, [&](size_t const t) {
+        size_t * const myCounts = counts.data() + (t*ranges);
+        size_t const end = Parallel::blockStart(num, t+1, numThreads);
+        for (size_t i = Parallel::blockStart(num, t, numThreads); i < end; \
+            ++i) {
+          ++myCounts[static_cast<size_t>(keys[i]) >> shift];
+        }
+      });
+
+      // offsets in (range, thread) order
+      std::vector<size_t> rangeStart(ranges+1);
+      size_t offset = 0;
+      for (size_t r = 0; r < ranges; ++r) {
+        rangeStart[r] = offset;
+        for (size_t t = 0; t < numThreads; ++t) {
+          size_t const count = counts[(t*ranges) + r];
+          counts[(t*ranges) + r] = offset;
+          offset += count;
+        }
+      }
+      rangeStart[ranges] = offset;
+
+      std::unique_ptr<K[]> groupedKeys(new K[num]);
+      std::unique_ptr<I[]> groupedIndex(new I[num]);
+      Parallel::run(numThreads, [&](size_t const t) {
+        size_t * const myOffsets = counts.data() + (t*ranges);
+        size_t const end = Parallel::blockStart(num, t+1, numThreads);
+        for (size_t i = Parallel::blockStart(num, t, numThreads); i < end; \
+            ++i) {
+          K const key = keys[i];
+          size_t const pos = myOffsets[static_cast<size_t>(key) >> shift]++;
+          groupedKeys[pos] = key;
+          groupedIndex[pos] = static_cast<I>(i);
+        }
+      });
+
+      // counting sort each range
+      size_t const width = static_cast<size_t>(1) << shift;
+      std::vector<std::vector<size_t>> localCounts(numThreads);
+      Parallel::forDynamic(numThreads, ranges, \
+          [&](size_t const r, size_t const t) {
+        std::vector<size_t> & keyCounts = localCounts[t];
+        keyCounts.assign(width+1, 0);
+
+        size_t const start = rangeStart[r];
+        size_t const end = rangeStart[r+1];
+        size_t const base = r << shift;
+        for (size_t i = start; i < end; ++i) {
+          ++keyCounts[static_cast<size_t>(groupedKeys[i]) - base];
+        }
+
+        sl::VectorMath::prefixSumExclusive(keyCounts.data(), \
+            keyCounts.size());
+
+        for (size_t i = start; i < end; ++i) {
+          size_t const pos = start + \
+              keyCounts[static_cast<size_t>(groupedKeys[i]) - base]++;
+          out[pos] = groupedIndex[i];
+        }
+
+        if (seeds != nullptr) {
+          std::mt19937 rng(seeds[r]);
+          size_t keyStart = start;
+          for (size_t k = 0; keyStart < end; ++k) {
+            size_t const keyEnd = start + keyCounts[k];
+            sl::Random::pseudoShuffle(out+keyStart, keyEnd - keyStart, rng);
+            keyStart = keyEnd;
+          }
+        }
+      });
+    }
+
+
+    /**
+    * @brief Get the unsigned representation of a key, which orders the same
+    * as the key.
+    *
+    * @tparam K The key type.
+    * @param key The key.
+    *
+    * @return The unsigned representation.
+    */
+    template<typename K>
+    static typename RadixKey<K>::type radixBits(
+        K const key) noexcept
+    {
+      return radixBits(key, std::is_floating_point<K>());
+    }
+
+
+    /**
+    * @brief Get the unsigned representation of an integer. For signed keys,
+    * this flips the sign bit.
+    *
+    * @tparam K The key type.
+    * @param key The key.
+    *
+    * @return The unsigned representation.
+    */
+    template<typename K>
+    static typename RadixKey<K>::type radixBits(
+        K const key,
+        std::false_type) noexcept
+    {
+      using U = typename RadixKey<K>::type;
+
+      return std::is_signed<K>::value ? \
+          static_cast<U>(static_cast<U>(key) ^ \
+              (static_cast<U>(1) << (sizeof(K)*8 - 1))) : \
+          static_cast<U>(key);
+    }
+
+
+    /**
+    * @brief Get the unsigned representation of a floating point number. The
+    * sign bit of positive numbers is set, and all bits of negative numbers
+    * are flipped. NaNs map to the maximum.
+    *
+    * @tparam K The key type.
+    * @param key The key.
+    *
+    * @return The unsigned representation.
+    */
+    template<typename K>
+    static typename RadixKey<K>::type radixBits(
+        K const key,
+        std::true_type) noexcept
+    {
+      using U = typename RadixKey<K>::type;
+
+      if (key != key) {
+        return ~static_cast<U>(0);
+      }
+
+      U bits;
+      std::memcpy(&bits, &key, sizeof(K));
+
+      U const sign = static_cast<U>(1) << (sizeof(K)*8 - 1);
+      return (bits & sign) != 0 ? static_cast<U>(~bits) : \
+          static_cast<U>(bits | sign);
+    }
+
+
+    /**
+    * @brief Compute the histogram of every digit of a set of keys.
+    *
+    * @tparam K The key type.
+    * @tparam BITS The number of bits per digit.
+    * @param keys The keys.
+    * @param start The first key to count.
+    * @param end The last key to count (exclusive).
+    * @param counts The histograms (RADIX entries per pass, must be zeroed).
+    */
+    template<typename K, size_t BITS>
+    static void radixHistogram(
+        K const * const keys,
+        size_t const start,
+        size_t const end,
+        size_t * const counts) noexcept
+    {
+      constexpr size_t const RADIX = static_cast<size_t>(1) << BITS;
+      constexpr size_t const MASK = RADIX - 1;
+      constexpr size_t const PASSES = ((sizeof(K)*8) + BITS - 1) / BITS;
+
+      for (size_t i = start; i < end; ++i) {
+        uint64_t const bits = radixBits(keys[i]);
+        for (size_t pass = 0; pass < PASSES; ++pass) {
+          ++counts[(pass*RADIX) + ((bits >> (pass*BITS)) & MASK)];
+        }
+      }
+    }
+
+
+    /**
+    * @brief Scatter a block of keys (and their payloads) by one digit.
+    *
+    * @tparam K The key type.
+    * @tparam V The payload type.
+    * @tparam BITS The number of bits per digit.
+    * @tparam P How to treat the payload.
+    * @param inKeys The keys to scatter.
+    * @param inValues The payloads to scatter (null on the first pass when
+    * generating an index).
+    * @param start The first key of the block.
+    * @param end The last key of the block (exclusive).
+    * @param shift The shift of the digit.
+    * @param offsets The position to write each digit to next.
+    * @param outKeys The keys scattered.
+    * @param outValues The payloads scattered.
+    */
+    template<typename K, typename V, size_t BITS, int P>
+    static void radixScatter(
+        K const * const inKeys,
+        V const * const inValues,
+        size_t const start,
+        size_t const end,
+        size_t const shift,
+        size_t * const offsets,
+        K * const outKeys,
+        V * const outValues) noexcept
+    {
+      constexpr uint64_t const MASK = (static_cast<uint64_t>(1) << BITS) - 1;
+
+      for (size_t i = start; i < end; ++i) {
+        K const key = inKeys[i];
+        size_t const pos = offsets[ \
+            (static_cast<uint64_t>(radixBits(key)) >> shift) & MASK]++;
+        outKeys[pos] = key;
+        radixPayload(inValues, i, outValues, pos, \
+            std::integral_constant<int, P>());
+      }
+    }
+
+
+    /**
+    * @brief Move no payload.
+    */
+    template<typename V>
+    static inline void radixPayload(
+        V const *,
+        size_t,
+        V *,
+        size_t,
+        std::integral_constant<int, Payload::NONE>) noexcept
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Move a payload with its key.
+    *
+    * @tparam V The payload type.
+    * @param in The payloads to read from.
+    * @param from The position to read.
+    * @param out The payloads to write to.
+    * @param to The position to write.
+    */
+    template<typename V>
+    static inline void radixPayload(
+        V const * const in,
+        size_t const from,
+        V * const out,
+        size_t const to,
+        std::integral_constant<int, Payload::CARRY>) noexcept
+    {
+      out[to] = in[from];
+    }
+
+
+    /**
+    * @brief Move an index with its key, generating the index from the
+    * position on the first pass.
+    *
+    * @tparam V The index type.
+    * @param in The indices to read from (null on the first pass).
+    * @param from The position to read.
+    * @param out The indices to write to.
+    * @param to The position to write.
+    */
+    template<typename V>
+    static inline void radixPayload(
+        V const * const in,
+        size_t const from,
+        V * const out,
+        size_t const to,
+        std::integral_constant<int, Payload::INDEX>) noexcept
+    {
+      out[to] = in == nullptr ? static_cast<V>(from) : in[from];
+    }
+
+
+    /**
+    * @brief Perform an LSD radix sort, optionally moving or generating a
+    * payload with the keys.
+    *
+    * @tparam K The key type.
+    * @tparam V The payload type.
+    * @tparam BITS The number of bits per digit.
+    * @tparam P How to treat the payload.
+    * @param keys The keys to sort.
+    * @param values The payloads (if any).
+    * @param num The number of keys.
+    * @param keyScratch Scratch memory of at least num keys.
+    * @param valueScratch Scratch memory of at least num payloads (if any).
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename V, size_t BITS, int P>
+    static void radixSort(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        K * const keyScratch,
+        V * const valueScratch,
+        size_t const numThreads)
+    {
+      static_assert(RadixKey<K>::SUPPORTED, \
+          "Must by integral, float, or double type.");
+      static_assert(BITS > 0 && BITS <= 11, "Digits must be 1 to 11 bits.");
+
+      constexpr size_t const RADIX = static_cast<size_t>(1) << BITS;
+      constexpr size_t const PASSES = ((sizeof(K)*8) + BITS - 1) / BITS;
+
+      // there's no point in threads with less than a histogram's worth of
+      // keys each
+      size_t const threads = std::max(static_cast<size_t>(1), \
+          std::min(numThreads, num / RADIX));
+
+      // build the histogram of every digit at once, for the whole set of
+      // keys in the first histograms, and for each thread's block after
+      std::vector<size_t> counts(PASSES*RADIX*(threads > 1 ? threads+1 : 1), \
+          0);
+      if (threads == 1) {
+        radixHistogram<K, BITS>(keys, 0, num, counts.data());
+      } else {
+        Parallel::run(threads, [&](size_t const t) {
+          radixHistogram<K, BITS>(keys, \
+              Parallel::blockStart(num, t, threads), \
+              Parallel::blockStart(num, t+1, threads), \
+              counts.data() + ((t+1)*PASSES*RADIX));
+        });
+        for (size_t t = 0; t < threads; ++t) {
+          size_t const * const threadCounts = counts.data() + \
+              ((t+1)*PASSES*RADIX);
+          for (size_t i = 0; i < PASSES*RADIX; ++i) {
+            counts[i] += threadCounts[i];
+          }
+        }
+      }
+
+      K * inKeys = keys;
+      K * outKeys = keyScratch;
+      V * inValues = P == Payload::INDEX ? nullptr : values;
+      V * outValues = P == Payload::INDEX ? values : valueScratch;
+      bool firstPass = true;
+
+      for (size_t pass = 0; pass < PASSES; ++pass) {
+        size_t * const digitCounts = counts.data() + (pass*RADIX);
+        size_t const shift = pass*BITS;
+
+        // skip digits which are the same for every key
+        uint64_t const firstDigit = num > 0 ? \
+            (static_cast<uint64_t>(radixBits(keys[0])) >> shift) & \
+            (RADIX-1) : 0;
+        if (digitCounts[firstDigit] == num) {
+          continue;
+        }
+
+        if (threads == 1) {
+          // the histogram of the whole set doesn't depend on its order
+          sl::VectorMath::prefixSumExclusive(digitCounts, RADIX);
+          radixScatter<K, V, BITS, P>(inKeys, inValues, 0, num, shift, \
+              digitCounts, outKeys, outValues);
+        } else {
+          // the blocks' histograms are from the original order, so recount
+          // them after the first pass
+          if (!firstPass) {
+            Parallel::run(threads, [&](size_t const t) {
+              size_t * const threadCounts = counts.data() + \
+                  ((t+1)*PASSES*RADIX) + (pass*RADIX);
+              std::fill(threadCounts, threadCounts+RADIX, 0);
+              size_t const end = Parallel::blockStart(num, t+1, threads);
+              for (size_t i = Parallel::blockStart(num, t, threads); \
+                  i < end; ++i) {
+                ++threadCounts[(static_cast<uint64_t>(radixBits( \
+                    inKeys[i])) >> shift) & (RADIX-1)];
+              }
+            });
+          }
+
+          // offsets in (digit, thread) order
+          size_t offset = 0;
+          for (size_t d = 0; d < RADIX; ++d) {
+            for (size_t t = 0; t < threads; ++t) {
+              size_t & count = counts[((t+1)*PASSES*RADIX) + (pass*RADIX) + d];
+              size_t const c = count;
+              count = offset;
+              offset += c;
+            }
+          }
+
+          Parallel::run(threads, [&](size_t const t) {
+            radixScatter<K, V, BITS, P>(inKeys, inValues, \
+                Parallel::blockStart(num, t, threads), \
+                Parallel::blockStart(num, t+1, threads), shift, \
+                counts.data() + ((t+1)*PASSES*RADIX) + (pass*RADIX), \
+                outKeys, outValues);
+          });
+        }
+
+        std::swap(inKeys, outKeys);
+        if (P == Payload::INDEX && inValues == nullptr) {
+          inValues = values;
+          outValues = valueScratch;
+        } else if (P != Payload::NONE) {
+          std::swap(inValues, outValues);
+        }
+        firstPass = false;
+      }
+
+      if (inKeys != keys) {
+        std::copy(inKeys, inKeys+num, keys);
+      }
+      if (P == Payload::INDEX && inValues == nullptr) {
+        // no passes were needed
+        for (size_t i = 0; i < num; ++i) {
+          radixPayload<V>(nullptr, i, values, i, \
+              std::integral_constant<int, P>());
+        }
+      } else if (P != Payload::NONE && inValues != values) {
+        std::copy(inValues, inValues+num, values);
+      }
+    }
+
+
+    /**
+    * @brief Sort each segment of an array independently.
+    *
+    * @tparam O The offset type.
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param offsets The start of each segment.
+    * @param numSegments The number of segments.
+    * @param keys The keys to sort.
+    * @param values The values (null if there is no payload).
+    * @param numThreads The number of threads to use.
+    */
+    template<typename O, typename K, typename V, bool PAYLOAD>
+    static void segmentedSort(
+        O const * const offsets,
+        size_t const numSegments,
+        K * const keys,
+        V * const values,
+        size_t const numThreads)
+    {
+      static_assert(std::is_integral<O>::value, "Must by integral type.");
+
+      if (numSegments == 0) {
+        return;
+      }
+
+      size_t const threads = std::max(numThreads, static_cast<size_t>(1));
+      size_t const total = static_cast<size_t>(offsets[numSegments] - \
+          offsets[0]);
+
+      // bin the segments: each long one is its own task, and short ones are
+      // grouped into chunks of consecutive segments
+      std::vector<size_t> huge;
+      std::vector<size_t> large;
+      std::vector<size_t> chunks;
+      size_t chunkSize = 0;
+      for (size_t s = 0; s < numSegments; ++s) {
+        size_t const length = static_cast<size_t>(offsets[s+1] - offsets[s]);
+        if (length > SortingNetwork::MAX_SIZE) {
+          if (threads > 1 && length*threads >= total) {
+            huge.push_back(s);
+          } else {
+            large.push_back(s);
+          }
+        } else if (length > 1) {
+          if (chunks.empty() || chunkSize >= SEGMENT_CHUNK_SIZE) {
+            chunks.push_back(s);
+            chunkSize = 0;
+          }
+          chunkSize += length;
+        }
+      }
+      chunks.push_back(numSegments);
+
+      std::vector<std::vector<K>> keyScratch(threads);
+      std::vector<std::vector<V>> valueScratch(PAYLOAD ? threads : 0);
+
+      for (size_t const s : huge) {
+        sortSegment<O, K, V, PAYLOAD>(offsets, s, keys, values, \
+            keyScratch[0], PAYLOAD ? &valueScratch[0] : nullptr, threads);
+      }
+
+      std::sort(large.begin(), large.end(), \
+          [offsets](size_t const a, size_t const b) {
+        return offsets[a+1] - offsets[a] > offsets[b+1] - offsets[b];
+      });
+
+      size_t const numLarge = large.size();
+      size_t const numChunks = chunks.size() - 1;
+      Parallel::forDynamic(threads, numLarge + numChunks, \
+          [&](size_t const task, size_t const threadId) {
+        if (task < numLarge) {
+          sortSegment<O, K, V, PAYLOAD>(offsets, large[task], keys, values, \
+              keyScratch[threadId], \
+              PAYLOAD ? &valueScratch[threadId] : nullptr, 1);
+        } else {
+          size_t const chunk = task - numLarge;
+          for (size_t s = chunks[chunk]; s < chunks[chunk+1]; ++s) {
+            size_t const start = static_cast<size_t>(offsets[s]);
+            size_t const length = static_cast<size_t>(offsets[s+1]) - start;
+            if (length <= SortingNetwork::MAX_SIZE) {
+              if (PAYLOAD) {
+                SortingNetwork::sort(keys+start, values+start, length);
+              } else {
+                SortingNetwork::sort(keys+start, length);
+              }
+            }
+          }
+        }
+      });
+    }
+
+
+    /**
+    * @brief Sort a single long segment.
+    *
+    * @tparam O The offset type.
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param offsets The start of each segment.
+    * @param segment The segment to sort.
+    * @param keys The keys to sort.
+    * @param values The values (null if there is no payload).
+    * @param keyScratch The key scratch memory to grow and use.
+    * @param valueScratch The value scratch memory to grow and use (null if
+    * there is no payload).
+    * @param numThreads The number of threads to use.
+    */
+    template<typename O, typename K, typename V, bool PAYLOAD>
+    static void sortSegment(
+        O const * const offsets,
+        size_t const segment,
+        K * const keys,
+        V * const values,
+        std::vector<K> & keyScratch,
+        std::vector<V> * const valueScratch,
+        size_t const numThreads)
+    {
+      size_t const start = static_cast<size_t>(offsets[segment]);
+      size_t const length = static_cast<size_t>(offsets[segment+1]) - start;
+
+      sortLong<K, V, PAYLOAD>(keys+start, PAYLOAD ? values+start : nullptr, \
+          length, keyScratch, valueScratch, numThreads, \
+          std::integral_constant<bool, RadixKey<K>::SUPPORTED>());
+    }
+
+
+    /**
+    * @brief Sort a long segment with a radix sort.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys of the segment.
+    * @param values The values of the segment (null if there is no payload).
+    * @param num The length of the segment.
+    * @param keyScratch The key scratch memory to grow and use.
+    * @param valueScratch The value scratch memory to grow and use (null if
+    * there is no payload).
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void sortLong(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        std::vector<K> & keyScratch,
+        std::vector<V> * const valueScratch,
+        size_t const numThreads,
+        std::true_type)
+    {
+      if (keyScratch.size() < num) {
+        keyScratch.resize(num);
+      }
+
+      if (PAYLOAD) {
+        if (valueScratch->size() < num) {
+          valueScratch->resize(num);
+        }
+        radixByKey<K, V>(keys, values, num, keyScratch.data(), \
+            valueScratch->data(), numThreads);
+      } else {
+        radix<K>(keys, num, keyScratch.data(), numThreads);
+      }
+    }
+
+
+    /**
+    * @brief Sort a long segment of keys unsupported by the radix sort with
+    * std::sort.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys of the segment.
+    * @param values The values of the segment (null if there is no payload).
+    * @param num The length of the segment.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void sortLong(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        std::vector<K> &,
+        std::vector<V> *,
+        size_t,
+        std::false_type)
+    {
+      if (PAYLOAD) {
+        SortingNetwork::sort(keys, values, num);
+      } else {
+        std::sort(keys, keys+num);
+      }
+    }
+
+
+    /**
+    * @brief Sort keys (and values) in place with an MSD radix sort.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys to sort.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys.
+    * @param numThreads The number of threads to use.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void inPlaceRadixSort(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        size_t const numThreads)
+    {
+      static_assert(RadixKey<K>::SUPPORTED, \
+          "Must by integral, float, or double type.");
+
+      constexpr size_t const RADIX = static_cast<size_t>(1) << INPLACE_BITS;
+      constexpr size_t const TOP_SHIFT = (sizeof(K)*8) - INPLACE_BITS;
+
+      size_t const threads = std::max(static_cast<size_t>(1), \
+          std::min(numThreads, num / RADIX));
+      if (threads == 1) {
+        americanFlag<K, V, PAYLOAD>(keys, values, num, TOP_SHIFT);
+        return;
+      }
+
+      // find the highest digit on which the keys differ, counting each
+      // thread's block in parallel
+      std::vector<size_t> threadCounts(threads*RADIX);
+      size_t counts[RADIX];
+      size_t shift = TOP_SHIFT;
+      while (true) {
+        Parallel::run(threads, [&](size_t const t) {
+          size_t * const local = threadCounts.data() + (t*RADIX);
+          std::fill(local, local+RADIX, 0);
+          size_t const end = Parallel::blockStart(num, t+1, threads);
+          for (size_t i = Parallel::blockStart(num, t, threads); i < end; \
+              ++i) {
+            ++local[digitOf(keys[i], shift)];
+          }
+        });
+
+        std::fill(counts, counts+RADIX, 0);
+        for (size_t t = 0; t < threads; ++t) {
+          for (size_t d = 0; d < RADIX; ++d) {
+            counts[d] += threadCounts[(t*RADIX) + d];
+          }
+        }
+
+        if (counts[digitOf(keys[0], shift)] < num) {
+          break;
+        } else if (shift == 0) {
+          // all keys are equal
+          return;
+        }
+        shift -= INPLACE_BITS;
+      }
+
+      flagPermute<K, V, PAYLOAD>(keys, values, shift, counts);
+
+      if (shift == 0) {
+        return;
+      }
+
+      std::vector<std::pair<size_t, size_t>> buckets;
+      size_t start = 0;
+      for (size_t d = 0; d < RADIX; ++d) {
+        if (counts[d] > 1) {
+          buckets.emplace_back(start, counts[d]);
+        }
+        start += counts[d];
+      }
+      std::sort(buckets.begin(), buckets.end(), \
+          [](std::pair<size_t, size_t> const & a, \
+          std::pair<size_t, size_t> const & b) {
+        return a.second > b.second;
+      });
+
+      Parallel::forDynamic(threads, buckets.size(), \
+          [&](size_t const b, size_t) {
+        size_t const first = buckets[b].first;
+        americanFlag<K, V, PAYLOAD>(keys+first, \
+            PAYLOAD ? values+first : nullptr, buckets[b].second, \
+            shift - INPLACE_BITS);
+      });
+    }
+
+
+    /**
+    * @brief Sort keys (and values) in place with a serial American flag
+    * sort, starting at the given digit.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys to sort.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys.
+    * @param shift The shift of the digit to sort by.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void americanFlag(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        size_t shift) noexcept
+    {
+      constexpr size_t const RADIX = static_cast<size_t>(1) << INPLACE_BITS;
+
+      if (num <= INPLACE_INSERTION_SIZE) {
+        radixInsertionSort<K, V, PAYLOAD>(keys, values, num);
+        return;
+      }
+
+      // skip digits which are the same for every key
+      size_t counts[RADIX];
+      while (true) {
+        std::fill(counts, counts+RADIX, 0);
+        for (size_t i = 0; i < num; ++i) {
+          ++counts[digitOf(keys[i], shift)];
+        }
+
+        if (counts[digitOf(keys[0], shift)] < num) {
+          break;
+        } else if (shift == 0) {
+          return;
+        }
+        shift -= INPLACE_BITS;
+      }
+
+      flagPermute<K, V, PAYLOAD>(keys, values, shift, counts);
+
+      if (shift > 0) {
+        size_t start = 0;
+        for (size_t d = 0; d < RADIX; ++d) {
+          if (counts[d] > 1) {
+            americanFlag<K, V, PAYLOAD>(keys+start, \
+                PAYLOAD ? values+start : nullptr, counts[d], \
+                shift - INPLACE_BITS);
+          }
+          start += counts[d];
+        }
+      }
+    }
+
+
+    /**
+    * @brief Permute keys (and values) in place into the buckets of their
+    * digit, by moving each misplaced key to the next free slot of its
+    * bucket, and continuing with the key it displaces until one belonging
+    * to the current bucket is found.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys to permute.
+    * @param values The values (null if there is no payload).
+    * @param shift The shift of the digit.
+    * @param counts The number of keys with each digit.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void flagPermute(
+        K * const keys,
+        V * const values,
+        size_t const shift,
+        size_t const * const counts) noexcept
+    {
+      constexpr size_t const RADIX = static_cast<size_t>(1) << INPLACE_BITS;
+
+      size_t next[RADIX];
+      size_t end[RADIX];
+      size_t offset = 0;
+      for (size_t d = 0; d < RADIX; ++d) {
+        next[d] = offset;
+        offset += counts[d];
+        end[d] = offset;
+      }
+
+      for (size_t b = 0; b < RADIX; ++b) {
+        while (next[b] < end[b]) {
+          K key = keys[next[b]];
+          V value = PAYLOAD ? values[next[b]] : V();
+          size_t d = digitOf(key, shift);
+          while (d != b) {
+            size_t const pos = next[d]++;
+            std::swap(key, keys[pos]);
+            if (PAYLOAD) {
+              std::swap(value, values[pos]);
+            }
+            d = digitOf(key, shift);
+          }
+          keys[next[b]] = key;
+          if (PAYLOAD) {
+            values[next[b]] = value;
+          }
+          ++next[b];
+        }
+      }
+    }
+
+
+    /**
+    * @brief Insertion sort keys (and values) by their radix representation.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys to sort.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void radixInsertionSort(
+        K * const keys,
+        V * const values,
+        size_t const num) noexcept
+    {
+      for (size_t i = 1; i < num; ++i) {
+        K const key = keys[i];
+        V const value = PAYLOAD ? values[i] : V();
+        typename RadixKey<K>::type const bits = radixBits(key);
+        size_t j = i;
+        while (j > 0 && bits < radixBits(keys[j-1])) {
+          keys[j] = keys[j-1];
+          if (PAYLOAD) {
+            values[j] = values[j-1];
+          }
+          --j;
+        }
+        keys[j] = key;
+        if (PAYLOAD) {
+          values[j] = value;
+        }
+      }
+    }
+
+
+    /**
+    * @brief Get the in-place radix sort digit of a key.
+    *
+    * @tparam K The key type.
+    * @param key The key.
+    * @param shift The shift of the digit.
+    *
+    * @return The digit.
+    */
+    template<typename K>
+    static inline size_t digitOf(
+        K const key,
+        size_t const shift) noexcept
+    {
+      return static_cast<size_t>((static_cast<uint64_t>(radixBits(key)) >> \
+          shift) & ((static_cast<uint64_t>(1) << INPLACE_BITS) - 1));
+    }
+
+
+    /**
+    * @brief Select the k-th element of a range with the Floyd-Rivest
+    * algorithm.
+    *
+    * @tparam T The type of element.
+    * @tparam C The comparator type.
+    * @param data The array.
+    * @param left The first element of the range.
+    * @param right The last element of the range (inclusive).
+    * @param k The position to select.
+    * @param compare The comparator.
+    * @param budget The number of partitioning steps to allow before falling
+    * back to std::nth_element.
+    */
+    template<typename T, typename C>
+    static void floydRivest(
+        T * const data,
+        ptrdiff_t left,
+        ptrdiff_t right,
+        ptrdiff_t const k,
+        C const & compare,
+        size_t budget)
+    {
+      while (right > left) {
+        if (budget == 0) {
+          std::nth_element(data+left, data+k, data+right+1, compare);
+          return;
+        }
+        --budget;
+
+        if (right - left > 600) {
+          // select from a sample around where the k-th element is expected,
+          // to get two elements which closely bracket it
+          double const n = static_cast<double>(right - left + 1);
+          double const i = static_cast<double>(k - left + 1);
+          double const z = std::log(n);
+          double const s = 0.5 * std::exp(2.0 * z / 3.0);
+          double const sd = 0.5 * std::sqrt(z * s * (n - s) / n) * \
+              (i < n / 2.0 ? -1.0 : 1.0);
+          ptrdiff_t const newLeft = std::max(left, static_cast<ptrdiff_t>( \
+              static_cast<double>(k) - (i * s / n) + sd));
+          ptrdiff_t const newRight = std::min(right, static_cast<ptrdiff_t>( \
+              static_cast<double>(k) + ((n - i) * s / n) + sd));
+          floydRivest(data, newLeft, newRight, k, compare, budget);
+        }
+
+        // partition around the k-th element
+        T const pivot = data[k];
+        ptrdiff_t i = left;
+        ptrdiff_t j = right;
+        std::swap(data[left], data[k]);
+        if (compare(pivot, data[right])) {
+          std::swap(data[right], data[left]);
+        }
+        while (i < j) {
+          std::swap(data[i], data[j]);
+          ++i;
+          --j;
+          while (compare(data[i], pivot)) {
+            ++i;
+          }
+          while (compare(pivot, data[j])) {
+            --j;
+          }
+        }
+        if (!compare(data[left], pivot) && !compare(pivot, data[left])) {
+          std::swap(data[left], data[j]);
+        } else {
+          ++j;
+          std::swap(data[j], data[right]);
+        }
+
+        if (j <= k) {
+          left = j + 1;
+        }
+        if (k <= j) {
+          right = j - 1;
+        }
+      }
+    }
+
+
+    /**
+    * @brief Get the floor of the base two logarithm of a number.
+    *
+    * @param num The number (greater than zero).
+    *
+    * @return The logarithm.
+    */
+    static size_t floorLog2(
+        size_t num) noexcept
+    {
+      size_t log = 0;
+      while (num > 1) {
+        num >>= 1;
+        ++log;
+      }
+      return log;
+    }
+
+
+    /**
+    * @brief Generate the sorted permutation of keys in [0,maxKey] with a
+    * counting sort. The counts are reused if they already have the capacity
+    * for the key range.
+    *
+    * @tparam K The key type.
+    * @tparam I The index type.
+    * @tparam C The count type (must be able to hold num).
+    * @param keys The keys.
+    * @param num The number of keys.
+    * @param maxKey The maximum key (inclusive).
+    * @param counts The counts (resized to maxKey+1).
+    * @param out The permutation (output).
+    */
+    template<typename K, typename I, typename C>
+    static void countingSort(
+        K const * const keys,
+        size_t const num,
+        size_t const maxKey,
+        std::vector<C> & counts,
+        I * const out)
+    {
+      counts.assign(maxKey+1, 0);
+
+      for (size_t i = 0; i < num; ++i) {
+        ASSERT_LESSEQUAL(static_cast<size_t>(keys[i]), maxKey);
+        ++counts[static_cast<size_t>(keys[i])];
+      }
+
+      sl::VectorMath::prefixSumExclusive(counts.data(), counts.size());
+
+      for (size_t i = 0; i < num; ++i) {
+        out[counts[static_cast<size_t>(keys[i])]++] = static_cast<I>(i);
+      }
+    }
+
+
+    /**
+    * @brief Shuffle the indices of each key of a permutation generated by
+    * countingSort().
+    *
+    * @tparam C The count type.
+    * @tparam I The index type.
+    * @tparam URBG The random source type.
+    * @param counts The counts after the sort (the end of each key's indices).
+    * @param num The number of keys.
+    * @param out The permutation.
+    * @param rng The random source.
+    */
+    template<typename C, typename I, typename URBG>
+    static void shuffleBuckets(
+        C const * const counts,
+        size_t const num,
+        I * const out,
+        URBG&& rng)
+    {
+      size_t start = 0;
+      for (size_t k = 0; start < num; ++k) {
+        size_t const end = static_cast<size_t>(counts[k]);
+        sl::Random::pseudoShuffle(out+start, end - start, rng);
+        start = end;
+      }
+    }
 };
 
 
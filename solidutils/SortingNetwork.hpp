@@ -0,0 +1,898 @@
+/**
+ * @file SortingNetwork.hpp
+ * @brief The SortingNetwork class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-05-11
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_SORTINGNETWORK_HPP
+#define SOLIDUTILS_INCLUDE_SORTINGNETWORK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SOLIDUTILS_SORTINGNETWORK_AVX2 1
+#endif
+
+namespace sl
+{
+
+
+/**
+* @brief The SortingNetwork class contains static functions for sorting short
+* arrays (up to a few hundred elements), such as the adjacency lists of a
+* graph, without the per-call overhead of a general purpose sort.
+*
+* When compiled with AVX2 support (e.g., `-mavx2` or `-march=native`), arrays
+* of 32-bit integer keys (and 32-bit payloads) are sorted in blocks of 64
+* using a sorting network across eight registers, followed by a transpose,
+* and the resulting runs of eight are merged using bitonic merges in
+* registers. Otherwise, a scalar network or merge sort does not beat
+* std::sort, so keys alone are passed to it, and key-value pairs are
+* insertion sorted when there are at most INSERTION_SIZE of them, or sorted
+* as pairs in a buffer on the stack. Neither path is stable.
+*/
+class SortingNetwork
+{
+  public:
+    /**
+    * @brief The largest array sorted by the networks and merges. Larger
+    * arrays are passed to std::sort.
+    */
+    static constexpr size_t const MAX_SIZE = 512;
+
+    /**
+    * @brief Without AVX2, key-value arrays up to this size are insertion
+    * sorted.
+    */
+    static constexpr size_t const INSERTION_SIZE = 16;
+
+    /**
+    * @brief Sort an array in place.
+    *
+    * @tparam T The type of element (must be arithmetic).
+    * @param data The array.
+    * @param num The number of elements.
+    */
+    template<typename T>
+    static void sort(
+        T * const data,
+        size_t const num) noexcept
+    {
+      static_assert(std::is_arithmetic<T>::value, "Must by arithmetic type.");
+
+      if (num > MAX_SIZE) {
+        std::sort(data, data+num);
+      } else {
+        dispatch<T, T, false>(data, nullptr, num);
+      }
+    }
+
+
+    /**
+    * @brief Sort an array of keys in place, keeping an array of values in
+    * sync with them. Arrays longer than MAX_SIZE are sorted via a temporary
+    * array of pairs.
+    *
+    * @tparam K The key type (must be arithmetic).
+    * @tparam V The value type (must be arithmetic).
+    * @param keys The keys.
+    * @param values The values.
+    * @param num The number of pairs.
+    */
+    template<typename K, typename V>
+    static void sort(
+        K * const keys,
+        V * const values,
+        size_t const num)
+    {
+      static_assert(std::is_arithmetic<K>::value, "Must by arithmetic type.");
+      static_assert(std::is_arithmetic<V>::value, "Must by arithmetic type.");
+
+      if (num > MAX_SIZE) {
+        std::unique_ptr<pair_storage<K, V>[]> pairs( \
+            new pair_storage<K, V>[num]);
+        pairSort(keys, values, num, pairs.get());
+      } else {
+        dispatch<K, V, true>(keys, values, num);
+      }
+    }
+
+
+  private:
+    /**
+    * @brief Uninitialized storage for a key-value pair, so that scratch
+    * buffers of pairs are not constructed (zeroed) before being written.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    */
+    template<typename K, typename V>
+    using pair_storage = typename std::aligned_storage< \
+        sizeof(std::pair<K, V>), alignof(std::pair<K, V>)>::type;
+
+
+    /**
+    * @brief Select the vectorized or scalar path based on the types.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys (at most MAX_SIZE).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void dispatch(
+        K * const keys,
+        V * const values,
+        size_t const num) noexcept
+    {
+      #ifdef SOLIDUTILS_SORTINGNETWORK_AVX2
+      sortShort<K, V, PAYLOAD>(keys, values, num, \
+          std::integral_constant<bool, \
+          (std::is_same<K, int32_t>::value || \
+          std::is_same<K, uint32_t>::value) && sizeof(V) == 4>());
+      #else
+      sortShort<K, V, PAYLOAD>(keys, values, num, std::false_type());
+      #endif
+    }
+
+
+    /**
+    * @brief Sort without vector instructions. Keys alone are passed to
+    * std::sort, short key-value arrays are insertion sorted, and longer ones
+    * are sorted as pairs in a buffer on the stack.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys (at most MAX_SIZE).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void sortShort(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        std::false_type) noexcept
+    {
+      if (!PAYLOAD) {
+        std::sort(keys, keys+num);
+      } else if (num <= INSERTION_SIZE) {
+        insertionSort<K, V, PAYLOAD>(keys, values, 0, num);
+      } else {
+        pair_storage<K, V> pairs[MAX_SIZE];
+        pairSort(keys, values, num, pairs);
+      }
+    }
+
+
+    /**
+    * @brief Sort keys and values by constructing an array of pairs in
+    * scratch memory, sorting it by key, and copying them back. As the keys
+    * and values are arithmetic, the pairs need not be destroyed.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @param keys The keys.
+    * @param values The values.
+    * @param num The number of pairs.
+    * @param storage Uninitialized scratch memory for num pairs.
+    */
+    template<typename K, typename V>
+    static void pairSort(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        pair_storage<K, V> * const storage) noexcept
+    {
+      for (size_t i = 0; i < num; ++i) {
+        new (storage + i) std::pair<K, V>(keys[i], values[i]);
+      }
+
+      std::pair<K, V> * const pairs = \
+          reinterpret_cast<std::pair<K, V>*>(storage);
+      std::sort(pairs, pairs+num, \
+          [](std::pair<K, V> const & a, std::pair<K, V> const & b) {
+        return a.first < b.first;
+      });
+      for (size_t i = 0; i < num; ++i) {
+        keys[i] = pairs[i].first;
+        values[i] = pairs[i].second;
+      }
+    }
+
+
+    /**
+    * @brief Sort the elements in a range using insertion sort.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param start The start of the range.
+    * @param end The end of the range (exclusive).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void insertionSort(
+        K * const keys,
+        V * const values,
+        size_t const start,
+        size_t const end) noexcept
+    {
+      for (size_t i = start + 1; i < end; ++i) {
+        K const key = keys[i];
+        V const value = PAYLOAD ? values[i] : V();
+        size_t j = i;
+        while (j > start && key < keys[j-1]) {
+          keys[j] = keys[j-1];
+          if (PAYLOAD) {
+            values[j] = values[j-1];
+          }
+          --j;
+        }
+        keys[j] = key;
+        if (PAYLOAD) {
+          values[j] = value;
+        }
+      }
+    }
+
+
+    /**
+    * @brief Merge sorted runs of a given length, bottom up, until the whole
+    * array is sorted.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @tparam VECTOR Whether or not to merge in registers (requires the runs
+    * and the array to be multiples of eight long).
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param keyBuffer Scratch memory for num keys.
+    * @param valueBuffer Scratch memory for num values (if there is a
+    * payload).
+    * @param num The number of keys.
+    * @param run The length of the sorted runs.
+    * @param vector Whether or not to merge in registers.
+    */
+    template<typename K, typename V, bool PAYLOAD, bool VECTOR>
+    static void mergeRuns(
+        K * const keys,
+        V * const values,
+        K * const keyBuffer,
+        V * const valueBuffer,
+        size_t const num,
+        size_t run,
+        std::integral_constant<bool, VECTOR> const vector) noexcept
+    {
+      K * inKeys = keys;
+      V * inValues = values;
+      K * outKeys = keyBuffer;
+      V * outValues = valueBuffer;
+
+      for (; run < num; run *= 2) {
+        for (size_t start = 0; start < num; start += 2*run) {
+          size_t const mid = std::min(start + run, num);
+          size_t const end = std::min(start + 2*run, num);
+          if (mid == end) {
+            std::copy(inKeys+start, inKeys+end, outKeys+start);
+            if (PAYLOAD) {
+              std::copy(inValues+start, inValues+end, outValues+start);
+            }
+          } else {
+            merge<K, V, PAYLOAD>(inKeys, inValues, start, mid, end, \
+                outKeys, outValues, vector);
+          }
+        }
+        std::swap(inKeys, outKeys);
+        std::swap(inValues, outValues);
+      }
+
+      if (inKeys != keys) {
+        std::copy(inKeys, inKeys+num, keys);
+        if (PAYLOAD) {
+          std::copy(inValues, inValues+num, values);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Merge two adjacent sorted runs.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param inKeys The keys to merge.
+    * @param inValues The values to merge.
+    * @param start The start of the first run.
+    * @param mid The end of the first run and start of the second.
+    * @param end The end of the second run.
+    * @param outKeys The keys merged (starting at start).
+    * @param outValues The values merged (starting at start).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void merge(
+        K const * const inKeys,
+        V const * const inValues,
+        size_t const start,
+        size_t const mid,
+        size_t const end,
+        K * const outKeys,
+        V * const outValues,
+        std::false_type) noexcept
+    {
+      size_t i = start;
+      size_t j = mid;
+      size_t o = start;
+      while (i < mid && j < end) {
+        size_t const next = inKeys[j] < inKeys[i] ? j++ : i++;
+        outKeys[o] = inKeys[next];
+        if (PAYLOAD) {
+          outValues[o] = inValues[next];
+        }
+        ++o;
+      }
+
+      size_t const rest = i < mid ? i : j;
+      size_t const restEnd = i < mid ? mid : end;
+      std::copy(inKeys+rest, inKeys+restEnd, outKeys+o);
+      if (PAYLOAD) {
+        std::copy(inValues+rest, inValues+restEnd, outValues+o);
+      }
+    }
+
+
+    #ifdef SOLIDUTILS_SORTINGNETWORK_AVX2
+    /**
+    * @brief The number of 32-bit lanes in a register.
+    */
+    static constexpr size_t const LANES = 8;
+
+    /**
+    * @brief A register of keys, and the register of values in the same
+    * lanes. Without a payload, operations on the values are dead and
+    * removed by the compiler.
+    */
+    struct lanes_struct
+    {
+      __m256i key;
+      __m256i value;
+    };
+
+
+    /**
+    * @brief Sort 32-bit keys by sorting each block of 64 with a network
+    * across eight registers and each remaining block of eight within a
+    * register, and merging the resulting runs in registers. The last
+    * partial block is insertion sorted and merged at the end.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param num The number of keys (at most MAX_SIZE).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void sortShort(
+        K * const keys,
+        V * const values,
+        size_t const num,
+        std::true_type) noexcept
+    {
+      if (num < LANES) {
+        insertionSort<K, V, PAYLOAD>(keys, values, 0, num);
+        return;
+      }
+
+      K keyBuffer[MAX_SIZE];
+      V valueBuffer[PAYLOAD ? MAX_SIZE : 1];
+
+      size_t const full = num - (num % LANES);
+
+      size_t start = 0;
+      for (; start + (LANES*LANES) <= full; start += LANES*LANES) {
+        sortColumns<K, V, PAYLOAD>(keys, values, start);
+      }
+      for (; start < full; start += LANES) {
+        lanes_struct x = load<K, V, PAYLOAD>(keys, values, start);
+        sortLanes<K, PAYLOAD>(x);
+        store<K, V, PAYLOAD>(keys, values, start, x);
+      }
+
+      mergeRuns<K, V, PAYLOAD>(keys, values, keyBuffer, valueBuffer, full, \
+          LANES, std::true_type());
+
+      if (full < num) {
+        insertionSort<K, V, PAYLOAD>(keys, values, full, num);
+        merge<K, V, PAYLOAD>(keys, values, 0, full, num, keyBuffer, \
+            valueBuffer, std::false_type());
+        std::copy(keyBuffer, keyBuffer+num, keys);
+        if (PAYLOAD) {
+          std::copy(valueBuffer, valueBuffer+num, values);
+        }
+      }
+    }
+
+
+    /**
+    * @brief Merge two adjacent sorted runs, each a multiple of eight long,
+    * eight keys at a time. The lowest eight of the two heads are written
+    * out, and the highest eight carried to be merged with the next block
+    * from whichever run has the lower next key.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param inKeys The keys to merge.
+    * @param inValues The values to merge.
+    * @param start The start of the first run.
+    * @param mid The end of the first run and start of the second.
+    * @param end The end of the second run.
+    * @param outKeys The keys merged (starting at start).
+    * @param outValues The values merged (starting at start).
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void merge(
+        K const * const inKeys,
+        V const * const inValues,
+        size_t const start,
+        size_t const mid,
+        size_t const end,
+        K * const outKeys,
+        V * const outValues,
+        std::true_type) noexcept
+    {
+      size_t i = start;
+      size_t j = mid;
+      size_t o = start;
+
+      lanes_struct low = load<K, V, PAYLOAD>(inKeys, inValues, i);
+      lanes_struct high = load<K, V, PAYLOAD>(inKeys, inValues, j);
+      i += LANES;
+      j += LANES;
+      mergeLanes<K, PAYLOAD>(low, high);
+      store<K, V, PAYLOAD>(outKeys, outValues, o, low);
+      o += LANES;
+
+      while (i < mid || j < end) {
+        size_t next;
+        if (j == end || (i < mid && !(inKeys[j] < inKeys[i]))) {
+          next = i;
+          i += LANES;
+        } else {
+          next = j;
+          j += LANES;
+        }
+        low = load<K, V, PAYLOAD>(inKeys, inValues, next);
+        mergeLanes<K, PAYLOAD>(low, high);
+        store<K, V, PAYLOAD>(outKeys, outValues, o, low);
+        o += LANES;
+      }
+
+      store<K, V, PAYLOAD>(outKeys, outValues, o, high);
+    }
+
+
+    /**
+    * @brief Sort eight registers (64 keys) into eight sorted runs, by
+    * sorting each lane across the registers with a 19 comparator network,
+    * and transposing so that each lane becomes a register.
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param keys The keys.
+    * @param values The values (null if there is no payload).
+    * @param start The first of the 64 keys.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static void sortColumns(
+        K * const keys,
+        V * const values,
+        size_t const start) noexcept
+    {
+      lanes_struct r[LANES];
+      for (size_t i = 0; i < LANES; ++i) {
+        r[i] = load<K, V, PAYLOAD>(keys, values, start + (i*LANES));
+      }
+
+      exchange<K, PAYLOAD>(r[0], r[2]);
+      exchange<K, PAYLOAD>(r[1], r[3]);
+      exchange<K, PAYLOAD>(r[4], r[6]);
+      exchange<K, PAYLOAD>(r[5], r[7]);
+      exchange<K, PAYLOAD>(r[0], r[4]);
+      exchange<K, PAYLOAD>(r[1], r[5]);
+      exchange<K, PAYLOAD>(r[2], r[6]);
+      exchange<K, PAYLOAD>(r[3], r[7]);
+      exchange<K, PAYLOAD>(r[0], r[1]);
+      exchange<K, PAYLOAD>(r[2], r[3]);
+      exchange<K, PAYLOAD>(r[4], r[5]);
+      exchange<K, PAYLOAD>(r[6], r[7]);
+      exchange<K, PAYLOAD>(r[2], r[4]);
+      exchange<K, PAYLOAD>(r[3], r[5]);
+      exchange<K, PAYLOAD>(r[1], r[4]);
+      exchange<K, PAYLOAD>(r[3], r[6]);
+      exchange<K, PAYLOAD>(r[1], r[2]);
+      exchange<K, PAYLOAD>(r[3], r[4]);
+      exchange<K, PAYLOAD>(r[5], r[6]);
+
+      __m256i k[LANES];
+      __m256i v[LANES];
+      for (size_t i = 0; i < LANES; ++i) {
+        k[i] = r[i].key;
+        v[i] = r[i].value;
+      }
+      transpose(k);
+      if (PAYLOAD) {
+        transpose(v);
+      }
+      for (size_t i = 0; i < LANES; ++i) {
+        r[i].key = k[i];
+        r[i].value = v[i];
+        store<K, V, PAYLOAD>(keys, values, start + (i*LANES), r[i]);
+      }
+    }
+
+
+    /**
+    * @brief Transpose an 8x8 matrix of 32-bit elements held in eight
+    * registers.
+    *
+    * @param r The registers.
+    */
+    static inline void transpose(
+        __m256i * const r) noexcept
+    {
+      __m256i const t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+      __m256i const t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+      __m256i const t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+      __m256i const t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+      __m256i const t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+      __m256i const t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+      __m256i const t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+      __m256i const t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+      __m256i const u0 = _mm256_unpacklo_epi64(t0, t2);
+      __m256i const u1 = _mm256_unpackhi_epi64(t0, t2);
+      __m256i const u2 = _mm256_unpacklo_epi64(t1, t3);
+      __m256i const u3 = _mm256_unpackhi_epi64(t1, t3);
+      __m256i const u4 = _mm256_unpacklo_epi64(t4, t6);
+      __m256i const u5 = _mm256_unpackhi_epi64(t4, t6);
+      __m256i const u6 = _mm256_unpacklo_epi64(t5, t7);
+      __m256i const u7 = _mm256_unpackhi_epi64(t5, t7);
+
+      r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+      r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+      r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+      r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+      r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+      r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+      r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+      r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+    }
+
+
+    /**
+    * @brief Sort the eight keys of a register with a bitonic network.
+    *
+    * @tparam K The key type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param x The register.
+    */
+    template<typename K, bool PAYLOAD>
+    static inline void sortLanes(
+        lanes_struct & x) noexcept
+    {
+      // each mask marks the lanes which take the larger key of their pair
+      exchangeLanes<K, PAYLOAD, 1, 0x66>(x);
+      exchangeLanes<K, PAYLOAD, 2, 0x3C>(x);
+      exchangeLanes<K, PAYLOAD, 1, 0x5A>(x);
+      cleanLanes<K, PAYLOAD>(x);
+    }
+
+
+    /**
+    * @brief Sort the eight keys of a bitonic register.
+    *
+    * @tparam K The key type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param x The register.
+    */
+    template<typename K, bool PAYLOAD>
+    static inline void cleanLanes(
+        lanes_struct & x) noexcept
+    {
+      exchangeLanes<K, PAYLOAD, 4, 0xF0>(x);
+      exchangeLanes<K, PAYLOAD, 2, 0xCC>(x);
+      exchangeLanes<K, PAYLOAD, 1, 0xAA>(x);
+    }
+
+
+    /**
+    * @brief Merge two sorted registers, leaving the lowest eight keys sorted
+    * in the first and the highest eight sorted in the second.
+    *
+    * @tparam K The key type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param low The first register.
+    * @param high The second register.
+    */
+    template<typename K, bool PAYLOAD>
+    static inline void mergeLanes(
+        lanes_struct & low,
+        lanes_struct & high) noexcept
+    {
+      __m256i const reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+      high.key = _mm256_permutevar8x32_epi32(high.key, reverse);
+      high.value = _mm256_permutevar8x32_epi32(high.value, reverse);
+
+      exchange<K, PAYLOAD>(low, high);
+      cleanLanes<K, PAYLOAD>(low);
+      cleanLanes<K, PAYLOAD>(high);
+    }
+
+
+    /**
+    * @brief Compare-exchange the lanes of two registers, leaving the lower
+    * key of each lane in the first and the higher in the second.
+    *
+    * @tparam K The key type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @param a The first register.
+    * @param b The second register.
+    */
+    template<typename K, bool PAYLOAD>
+    static inline void exchange(
+        lanes_struct & a,
+        lanes_struct & b) noexcept
+    {
+      if (PAYLOAD) {
+        __m256i const swap = greater<K>(a.key, b.key);
+        __m256i const lowKey = _mm256_blendv_epi8(a.key, b.key, swap);
+        __m256i const lowValue = _mm256_blendv_epi8(a.value, b.value, swap);
+        b.key = _mm256_blendv_epi8(b.key, a.key, swap);
+        b.value = _mm256_blendv_epi8(b.value, a.value, swap);
+        a.key = lowKey;
+        a.value = lowValue;
+      } else {
+        __m256i const lowKey = minimum<K>(a.key, b.key);
+        b.key = maximum<K>(a.key, b.key);
+        a.key = lowKey;
+      }
+    }
+
+
+    /**
+    * @brief Compare-exchange pairs of lanes within a register.
+    *
+    * @tparam K The key type.
+    * @tparam PAYLOAD Whether or not there are values to keep in sync.
+    * @tparam DISTANCE The distance between the lanes of a pair (1, 2, or 4).
+    * @tparam MASK The lanes which take the larger key of their pair.
+    * @param x The register.
+    */
+    template<typename K, bool PAYLOAD, int DISTANCE, int MASK>
+    static inline void exchangeLanes(
+        lanes_struct & x) noexcept
+    {
+      std::integral_constant<int, DISTANCE> distance;
+      __m256i const key = partner(x.key, distance);
+
+      if (PAYLOAD) {
+        // lanes only take their partner's pair if its key is strictly
+        // better, so pairs with equal keys are never duplicated
+        __m256i const take = _mm256_blend_epi32(greater<K>(x.key, key), \
+            greater<K>(key, x.key), MASK);
+        x.value = _mm256_blendv_epi8(x.value, partner(x.value, distance), \
+            take);
+        x.key = _mm256_blendv_epi8(x.key, key, take);
+      } else {
+        x.key = _mm256_blend_epi32(minimum<K>(x.key, key), \
+            maximum<K>(x.key, key), MASK);
+      }
+    }
+
+
+    /**
+    * @brief Swap adjacent lanes.
+    *
+    * @param x The register.
+    *
+    * @return The permuted register.
+    */
+    static inline __m256i partner(
+        __m256i const x,
+        std::integral_constant<int, 1>) noexcept
+    {
+      return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+
+
+    /**
+    * @brief Swap adjacent pairs of lanes.
+    *
+    * @param x The register.
+    *
+    * @return The permuted register.
+    */
+    static inline __m256i partner(
+        __m256i const x,
+        std::integral_constant<int, 2>) noexcept
+    {
+      return _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+
+    /**
+    * @brief Swap the halves of a register.
+    *
+    * @param x The register.
+    *
+    * @return The permuted register.
+    */
+    static inline __m256i partner(
+        __m256i const x,
+        std::integral_constant<int, 4>) noexcept
+    {
+      return _mm256_permute2x128_si256(x, x, 1);
+    }
+
+
+    /**
+    * @brief Compare the keys of two registers.
+    *
+    * @tparam K The key type.
+    * @param a The first register.
+    * @param b The second register.
+    *
+    * @return All bits set in each lane where a's key is greater.
+    */
+    template<typename K>
+    static inline __m256i greater(
+        __m256i const a,
+        __m256i const b) noexcept
+    {
+      if (std::is_signed<K>::value) {
+        return _mm256_cmpgt_epi32(a, b);
+      } else {
+        __m256i const bias = _mm256_set1_epi32(INT32_MIN);
+        return _mm256_cmpgt_epi32(_mm256_xor_si256(a, bias), \
+            _mm256_xor_si256(b, bias));
+      }
+    }
+
+
+    /**
+    * @brief Get the lower key of each lane.
+    *
+    * @tparam K The key type.
+    * @param a The first register.
+    * @param b The second register.
+    *
+    * @return The lower keys.
+    */
+    template<typename K>
+    static inline __m256i minimum(
+        __m256i const a,
+        __m256i const b) noexcept
+    {
+      return std::is_signed<K>::value ? _mm256_min_epi32(a, b) : \
+          _mm256_min_epu32(a, b);
+    }
+
+
+    /**
+    * @brief Get the higher key of each lane.
+    *
+    * @tparam K The key type.
+    * @param a The first register.
+    * @param b The second register.
+    *
+    * @return The higher keys.
+    */
+    template<typename K>
+    static inline __m256i maximum(
+        __m256i const a,
+        __m256i const b) noexcept
+    {
+      return std::is_signed<K>::value ? _mm256_max_epi32(a, b) : \
+          _mm256_max_epu32(a, b);
+    }
+
+
+    /**
+    * @brief Load eight keys (and values).
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to load.
+    * @param keys The keys.
+    * @param values The values.
+    * @param start The first key to load.
+    *
+    * @return The loaded registers.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static inline lanes_struct load(
+        K const * const keys,
+        V const * const values,
+        size_t const start) noexcept
+    {
+      lanes_struct x;
+      x.key = _mm256_loadu_si256(reinterpret_cast<__m256i const *>( \
+          keys + start));
+      x.value = PAYLOAD ? _mm256_loadu_si256( \
+          reinterpret_cast<__m256i const *>(values + start)) : \
+          _mm256_setzero_si256();
+      return x;
+    }
+
+
+    /**
+    * @brief Store eight keys (and values).
+    *
+    * @tparam K The key type.
+    * @tparam V The value type.
+    * @tparam PAYLOAD Whether or not there are values to store.
+    * @param keys The keys.
+    * @param values The values.
+    * @param start The position of the first key to store.
+    * @param x The registers.
+    */
+    template<typename K, typename V, bool PAYLOAD>
+    static inline void store(
+        K * const keys,
+        V * const values,
+        size_t const start,
+        lanes_struct const & x) noexcept
+    {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(keys + start), x.key);
+      if (PAYLOAD) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + start), \
+            x.value);
+      }
+    }
+    #endif
+};
+
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/**
+* @file Spinlock.hpp
+* @brief The Spinlock class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-20
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_SPINLOCK_HPP
+#define SOLIDUTILS_INCLUDE_SPINLOCK_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define SOLIDUTILS_SPINLOCK_PAUSE 1
+#endif
+
+
+namespace sl
+{
+
+/**
+* @brief The Spinlock class provides a lightweight mutual exclusion lock for
+* short critical sections. A waiting thread busy-waits, with a pause
+* instruction between reads, and yields to the operating system once it has
+* waited for SPIN_LIMIT reads, so that when threads outnumber cores the
+* holder of the lock is not starved of time slices. It satisfies the Lockable
+* requirements, so it can be used with std::lock_guard.
+*/
+class Spinlock
+{
+  public:
+    /**
+    * @brief The number of times to read the lock while waiting before
+    * yielding between reads.
+    */
+    static constexpr size_t const SPIN_LIMIT = 64;
+
+    /**
+    * @brief Create a new unlocked spinlock.
+    */
+    Spinlock() noexcept :
+      m_locked(false)
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Deleted copy constructor.
+    *
+    * @param rhs The lock to copy.
+    */
+    Spinlock(
+        Spinlock const & rhs) = delete;
+
+
+    /**
+    * @brief Deleted assignment operator.
+    *
+    * @param rhs The lock to copy.
+    *
+    * @return This lock.
+    */
+    Spinlock & operator=(
+        Spinlock const & rhs) = delete;
+
+
+    /**
+    * @brief Acquire the lock, waiting until it is available. While waiting,
+    * the lock is only read, so that the cache line is not contended.
+    */
+    void lock() noexcept
+    {
+      while (m_locked.exchange(true, std::memory_order_acquire)) {
+        size_t spins = 0;
+        while (m_locked.load(std::memory_order_relaxed)) {
+          if (spins < SPIN_LIMIT) {
+            pause();
+            ++spins;
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      }
+    }
+
+
+    /**
+    * @brief Acquire the lock if it is available.
+    *
+    * @return True if the lock was acquired.
+    */
+    bool try_lock() noexcept
+    {
+      return !m_locked.load(std::memory_order_relaxed) && \
+          !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+
+    /**
+    * @brief Release the lock.
+    */
+    void unlock() noexcept
+    {
+      m_locked.store(false, std::memory_order_release);
+    }
+
+
+  private:
+    std::atomic<bool> m_locked;
+
+
+    /**
+    * @brief Hint to the processor that this is a spin-wait loop, which
+    * reduces the power used and the penalty of leaving the loop.
+    */
+    static void pause() noexcept
+    {
+      #ifdef SOLIDUTILS_SPINLOCK_PAUSE
+      _mm_pause();
+      #endif
+    }
+};
+
+}
+
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file StaticFixedMap.hpp
+ * @brief The StaticFixedMap class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-03-23
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_STATICFIXEDMAP_HPP
+#define SOLIDUTILS_INCLUDE_STATICFIXEDMAP_HPP
+
+
+#include "ConstArray.hpp"
+#include "StaticFixedSet.hpp"
+
+#include <array>
+
+
+namespace sl
+{
+
+/**
+* @brief The StaticFixedMap class provides the same functionality as the
+* FixedMap class, but for a key space whose size N is known at compile time.
+* All storage is inline (no heap allocation), so it can live on the stack or
+* within other structures, and it is trivially copyable when K and V are.
+*
+* @tparam K The key type, must an integer.
+* @tparam V The value type, must be trivial.
+* @tparam N The size of the key space.
+*/
+template <typename K, typename V, size_t N>
+class StaticFixedMap
+{
+  public:
+    using index_type = typename StaticFixedIndex<N>::type;
+
+    static constexpr index_type const NULL_INDEX = \
+        static_cast<index_type>(-1);
+
+    /**
+    * @brief Create a new empty fixed map.
+    */
+    StaticFixedMap() noexcept :
+      m_size(0),
+      m_keys(),
+      m_values(),
+      m_index()
+    {
+      m_index.fill(NULL_INDEX);
+    }
+
+
+    /**
+    * @brief Check if an key exists in this map.
+    *
+    * @param key The key.
+    *
+    * @return True if the key is in the map.
+    */
+    bool has(
+        K const key) const noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, N);
+
+      return m_index[index] != NULL_INDEX;
+    }
+
+
+    /**
+    * @brief Get the value associated with a given key.
+    *
+    * @param key The key.
+    *
+    * @return The value.
+    */
+    V get(
+        K const key) const noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, N);
+      ASSERT_NOTEQUAL(m_index[index], NULL_INDEX);
+
+      return m_values[m_index[index]];
+    }
+
+
+    /**
+    * @brief Add an key-value pair to this map.
+    *
+    * @param key The key.
+    * @param value The value.
+    */
+    void add(
+        K const key,
+        V const value) noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, N);
+      ASSERT_EQUAL(m_index[index], NULL_INDEX);
+
+      m_keys[m_size] = key;
+      m_values[m_size] = value;
+
+      m_index[index] = m_size;
+
+      ++m_size;
+    }
+
+
+    /**
+    * @brief Add a value to the value associated with a key. If the key is not
+    * present, it is added with the given value.
+    *
+    * @param key The key.
+    * @param value The value to add.
+    */
+    void accumulate(
+        K const key,
+        V const value) noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, N);
+
+      if (m_index[index] == NULL_INDEX) {
+        add(key, value);
+      } else {
+        m_values[m_index[index]] += value;
+      }
+    }
+
+
+    /**
+    * @brief Remove an key-value pair from this map.
+    *
+    * @param key The key to remove.
+    */
+    void remove(
+        K const key) noexcept
+    {
+      size_t const index = static_cast<size_t>(key);
+
+      ASSERT_LESS(index, N);
+      ASSERT_NOTEQUAL(m_index[index], NULL_INDEX);
+
+      --m_size;
+      K const swapKey = m_keys[m_size];
+      V const swapValue = m_values[m_size];
+      index_type const place = m_index[index];
+      m_keys[place] = swapKey;
+      m_values[place] = swapValue;
+      m_index[static_cast<size_t>(swapKey)] = place;
+      m_index[index] = NULL_INDEX;
+    }
+
+
+    /**
+    * @brief Remove all key-value pairs from this map.
+    */
+    void clear() noexcept
+    {
+      for (size_t i = 0; i < m_size; ++i) {
+        m_index[static_cast<size_t>(m_keys[i])] = NULL_INDEX;
+      }
+      m_size = 0;
+    }
+
+
+    /**
+    * @brief Get the number of elements in the map.
+    *
+    * @return The number of elements.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Get the maximum size of this map.
+    *
+    * @return The maximum size.
+    */
+    static constexpr size_t maxSize() noexcept
+    {
+      return N;
+    }
+
+
+    /**
+    * @brief Get the keys in this map.
+    *
+    * @return The keys.
+    */
+    ConstArray<K> keys() const noexcept
+    {
+      return ConstArray<K>(m_keys.data(), m_size);
+    }
+
+
+    /**
+    * @brief Get the values in this map.
+    *
+    * @return The values.
+    */
+    ConstArray<V> values() const noexcept
+    {
+      return ConstArray<V>(m_values.data(), m_size);
+    }
+
+
+  private:
+    index_type m_size;
+    std::array<K, N> m_keys;
+    std::array<V, N> m_values;
+    std::array<index_type, N> m_index;
+};
+
+
+template <typename K, typename V, size_t N>
+constexpr typename StaticFixedMap<K, V, N>::index_type const \
+    StaticFixedMap<K, V, N>::NULL_INDEX;
+
+}
+
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file StaticFixedSet.hpp
+ * @brief The StaticFixedSet class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-03-23
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_STATICFIXEDSET_HPP
+#define SOLIDUTILS_INCLUDE_STATICFIXEDSET_HPP
+
+
+#include "Debug.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace sl
+{
+
+
+/**
+* @brief Select the smallest unsigned type which can index N elements and
+* still represent a null index.
+*
+* @tparam N The number of elements.
+*/
+template <size_t N>
+struct StaticFixedIndex
+{
+  using type = typename std::conditional<(N < UINT8_MAX), uint8_t,
+      typename std::conditional<(N < UINT16_MAX), uint16_t,
+      typename std::conditional<(N < UINT32_MAX), uint32_t,
+      uint64_t>::type>::type>::type;
+};
+
+
+/**
+* @brief The StaticFixedSet class provides the same functionality as the
+* FixedSet class, but for a universe whose size N is known at compile time.
+* All storage is inline (no heap allocation), so it can live on the stack or
+* within other structures, and it is trivially copyable when T is.
+*
+* @tparam T The type of element to store.
+* @tparam N The size of the set.
+*/
+template <typename T, size_t N>
+class StaticFixedSet
+{
+  public:
+    using index_type = typename StaticFixedIndex<N>::type;
+
+    static constexpr index_type const NULL_INDEX = \
+        static_cast<index_type>(-1);
+
+    /**
+    * @brief Create a new empty fixed set.
+    */
+    StaticFixedSet() noexcept :
+      m_size(0),
+      m_data(),
+      m_index()
+    {
+      m_index.fill(NULL_INDEX);
+    }
+
+
+    /**
+    * @brief Check if an element exists in this set.
+    *
+    * @param element The element.
+    *
+    * @return True if the element is in the set.
+    */
+    bool has(
+        T const element) const noexcept
+    {
+      size_t const index = static_cast<size_t>(element);
+
+      ASSERT_LESS(index, N);
+
+      return m_index[index] != NULL_INDEX;
+    }
+
+
+    /**
+    * @brief Add an element to this set.
+    *
+    * @param element The element to add.
+    */
+    void add(
+        T const element) noexcept
+    {
+      size_t const index = static_cast<size_t>(element);
+
+      ASSERT_LESS(index, N);
+      ASSERT_EQUAL(m_index[index], NULL_INDEX);
+
+      m_data[m_size] = element;
+      m_index[index] = m_size;
+
+      ++m_size;
+    }
+
+
+    /**
+    * @brief Remove an element from this set.
+    *
+    * @param element The element to remove.
+    */
+    void remove(
+        T const element) noexcept
+    {
+      size_t const index = static_cast<size_t>(element);
+
+      ASSERT_LESS(index, N);
+      ASSERT_NOTEQUAL(m_index[index], NULL_INDEX);
+
+      --m_size;
+      T const swap = m_data[m_size];
+      index_type const place = m_index[index];
+      m_data[place] = swap;
+      m_index[static_cast<size_t>(swap)] = place;
+      m_index[index] = NULL_INDEX;
+    }
+
+
+    /**
+    * @brief Remove all elements from this set.
+    */
+    void clear() noexcept
+    {
+      for (size_t i = 0; i < m_size; ++i) {
+        m_index[static_cast<size_t>(m_data[i])] = NULL_INDEX;
+      }
+      m_size = 0;
+    }
+
+
+    /**
+    * @brief Get the underlying array.
+    *
+    * @return The data.
+    */
+    T * data() noexcept
+    {
+      return m_data.data();
+    }
+
+
+    /**
+    * @brief Get the underlying array.
+    *
+    * @return The data.
+    */
+    T const * data() const noexcept
+    {
+      return m_data.data();
+    }
+
+
+    /**
+    * @brief Get the number of elements in the set.
+    *
+    * @return The number of elements.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Get the maximum size of this set.
+    *
+    * @return The maximum size.
+    */
+    static constexpr size_t maxSize() noexcept
+    {
+      return N;
+    }
+
+
+    /**
+    * @brief Get the beginning iterator.
+    *
+    * @return The iterator/pointer.
+    */
+    T const * begin() const noexcept
+    {
+      return m_data.data();
+    }
+
+
+    /**
+    * @brief Get the end iterator.
+    *
+    * @return The iterator/pointer.
+    */
+    T const * end() const noexcept
+    {
+      return m_data.data() + m_size;
+    }
+
+
+    /**
+    * @brief Get the beginning iterator (mutable).
+    *
+    * @return The iterator/pointer.
+    */
+    T * begin() noexcept
+    {
+      return m_data.data();
+    }
+
+
+    /**
+    * @brief Get the end iterator (mutable).
+    *
+    * @return The iterator/pointer.
+    */
+    T * end() noexcept
+    {
+      return m_data.data() + m_size;
+    }
+
+
+  private:
+    index_type m_size;
+    std::array<T, N> m_data;
+    std::array<index_type, N> m_index;
+};
+
+
+template <typename T, size_t N>
+constexpr typename StaticFixedSet<T, N>::index_type const \
+    StaticFixedSet<T, N>::NULL_INDEX;
+
+}
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * @file TopK.hpp
+ * @brief The TopK class.
+ * @author Dominique LaSalle <dominique@solidlake.com>
+ * Copyright 2019
+ * @version 1
+ * @date 2019-04-27
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#ifndef SOLIDUTILS_INCLUDE_TOPK_HPP
+#define SOLIDUTILS_INCLUDE_TOPK_HPP
+
+#include "Array.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace sl
+{
+
+
+/**
+* @brief The TopK class selects the k key-value pairs with the highest
+* priority from a stream, using O(k) memory. The pairs kept are stored in a
+* heap with the lowest priority pair at the root, which serves as the
+* threshold a new pair must beat to be kept. Once the structure is full, most
+* pairs of a long stream are rejected by a single comparison.
+*
+* The ordering follows FixedPriorityQueue: with the default comparator of
+* std::less the largest keys are kept, and with std::greater the smallest.
+* Values are not indexed, so a value may be added more than once.
+*
+* ```
+* TopK<float, int> best(10);
+* for (int v = 0; v < n; ++v) {
+*   best.add(gain[v], v);
+* }
+*
+* std::vector<float> keys(best.size());
+* std::vector<int> values(best.size());
+* best.drain(keys.data(), values.data());
+* ```
+*
+* @tparam K The key type.
+* @tparam V The value type.
+* @tparam C The comparator type, where `C()(a, b)` returns true if a has a
+* lower priority than b.
+*/
+template<typename K, typename V, typename C = std::less<K>>
+class TopK
+{
+  public:
+    /**
+    * @brief The number of keys checked against the threshold at once by
+    * `addMany()`.
+    */
+    static constexpr size_t const BLOCK_SIZE = 16;
+
+    /**
+    * @brief Create a new empty selector.
+    *
+    * @param k The number of pairs to keep.
+    * @param compare The comparator to order keys with.
+    */
+    TopK(
+        size_t const k,
+        C const & compare = C()) :
+      m_keys(k),
+      m_values(k),
+      m_size(0),
+      m_compare(compare)
+    {
+      // do nothing
+    }
+
+
+    /**
+    * @brief Offer a key-value pair. If k pairs are already kept, the pair
+    * replaces the lowest priority one if it has a higher priority.
+    *
+    * @param key The key/priority.
+    * @param value The value.
+    *
+    * @return True if the pair was kept.
+    */
+    bool add(
+        K const key,
+        V const value) noexcept
+    {
+      if (m_size < m_keys.size()) {
+        siftUp(m_size++, key, value);
+        return true;
+      } else if (m_size > 0 && m_compare(m_keys[0], key)) {
+        siftDown(0, key, value);
+        return true;
+      } else {
+        return false;
+      }
+    }
+
+
+    /**
+    * @brief Offer a set of key-value pairs. Once k pairs are kept, the keys
+    * are checked against the threshold a block at a time, without branching
+    * on each key, which compilers can vectorize for arithmetic key types.
+    *
+    * @param keys The keys.
+    * @param values The values.
+    * @param num The number of pairs.
+    */
+    void addMany(
+        K const * const keys,
+        V const * const values,
+        size_t const num) noexcept
+    {
+      size_t i = 0;
+      while (i < num && m_size < m_keys.size()) {
+        add(keys[i], values[i]);
+        ++i;
+      }
+
+      if (m_size == 0) {
+        // k is zero
+        return;
+      }
+
+      for (; i + BLOCK_SIZE <= num; i += BLOCK_SIZE) {
+        K const threshold = m_keys[0];
+        bool any = false;
+        for (size_t j = 0; j < BLOCK_SIZE; ++j) {
+          any |= m_compare(threshold, keys[i+j]);
+        }
+        if (any) {
+          for (size_t j = 0; j < BLOCK_SIZE; ++j) {
+            add(keys[i+j], values[i+j]);
+          }
+        }
+      }
+
+      for (; i < num; ++i) {
+        add(keys[i], values[i]);
+      }
+    }
+
+
+    /**
+    * @brief Get the key a new pair must beat to be kept, which is the lowest
+    * priority key kept. This is only valid when `size()` is `capacity()`.
+    *
+    * @return The threshold key.
+    */
+    K const & threshold() const noexcept
+    {
+      ASSERT_GREATER(m_size, 0);
+
+      return m_keys[0];
+    }
+
+
+    /**
+    * @brief Write the pairs kept in order of decreasing priority, and empty
+    * the selector.
+    *
+    * @param keys The array to write the keys to (must be of at least
+    * `size()`).
+    * @param values The array to write the values to (must be of at least
+    * `size()`).
+    */
+    void drain(
+        K * const keys,
+        V * const values) noexcept
+    {
+      size_t const num = m_size;
+
+      // heap sort in place, as the lowest priority pair is at the root
+      while (m_size > 1) {
+        --m_size;
+        K const key = m_keys[m_size];
+        V const value = m_values[m_size];
+        m_keys[m_size] = m_keys[0];
+        m_values[m_size] = m_values[0];
+        siftDown(0, key, value);
+      }
+
+      std::copy(m_keys.data(), m_keys.data() + num, keys);
+      std::copy(m_values.data(), m_values.data() + num, values);
+
+      m_size = 0;
+    }
+
+
+    /**
+    * @brief Get the number of pairs kept.
+    *
+    * @return The number of pairs.
+    */
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+
+    /**
+    * @brief Get the maximum number of pairs kept (k).
+    *
+    * @return The number of pairs.
+    */
+    size_t capacity() const noexcept
+    {
+      return m_keys.size();
+    }
+
+
+    /**
+    * @brief Remove all pairs.
+    */
+    void clear() noexcept
+    {
+      m_size = 0;
+    }
+
+
+  private:
+    Array<K> m_keys;
+    Array<V> m_values;
+    size_t m_size;
+    C m_compare;
+
+
+    /**
+    * @brief Correctly float a pair up into the heap, moving a hole up and
+    * writing the pair once at its final position.
+    *
+    * @param index The position of the hole to start from.
+    * @param key The key.
+    * @param value The value.
+    */
+    void siftUp(
+        size_t index,
+        K const key,
+        V const value) noexcept
+    {
+      while (index > 0) {
+        size_t const parent = (index - 1) / 2;
+        if (!m_compare(key, m_keys[parent])) {
+          break;
+        }
+        m_keys[index] = m_keys[parent];
+        m_values[index] = m_values[parent];
+        index = parent;
+      }
+
+      m_keys[index] = key;
+      m_values[index] = value;
+    }
+
+
+    /**
+    * @brief Correctly sink a pair into the heap, moving a hole down and
+    * writing the pair once at its final position.
+    *
+    * @param index The position of the hole to start from.
+    * @param key The key.
+    * @param value The value.
+    */
+    void siftDown(
+        size_t index,
+        K const key,
+        V const value) noexcept
+    {
+      while (true) {
+        size_t child = (index * 2) + 1;
+        if (child >= m_size) {
+          break;
+        }
+        if (child + 1 < m_size && m_compare(m_keys[child+1], m_keys[child])) {
+          ++child;
+        }
+        if (!m_compare(m_keys[child], key)) {
+          break;
+        }
+        m_keys[index] = m_keys[child];
+        m_values[index] = m_values[child];
+        index = child;
+      }
+
+      m_keys[index] = key;
+      m_values[index] = value;
+    }
+};
+
+
+template<typename K, typename V, typename C>
+constexpr size_t const TopK<K, V, C>::BLOCK_SIZE;
+
+
+}
+
+#endif
@@ -0,0 +1,143 @@
+/**
+* @file FixedMap_bench.cpp
+* @brief Benchmarks for the FixedMap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-02
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#include "FixedMap.hpp"
+#include "Random.hpp"
+#include "Timer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+
+using key_type = uint32_t;
+using value_type = uint32_t;
+
+}
+
+
+int main(
+    int argc,
+    char ** argv)
+{
+  // usage: FixedMap_bench [universe size] [number of lookups]
+  size_t const universe = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : \
+      100000000ULL;
+  size_t const numLookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : \
+      10000000ULL;
+
+  std::mt19937 rng(0);
+
+  // every other key, in random order
+  std::vector<key_type> keys(universe / 2);
+  std::vector<value_type> values(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = static_cast<key_type>(i*2);
+    values[i] = static_cast<value_type>(i);
+  }
+  sl::Random::pseudoShuffle(keys.data(), keys.size(), rng);
+
+  sl::Timer singleAdd;
+  {
+    sl::FixedMap<key_type, value_type> map(universe);
+    singleAdd.start();
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map.add(keys[i], values[i]);
+    }
+    singleAdd.stop();
+  }
+
+  sl::FixedMap<key_type, value_type> map(universe);
+
+  sl::Timer batchAdd;
+  batchAdd.start();
+  map.addMany(keys.data(), values.data(), keys.size());
+  batchAdd.stop();
+
+  std::vector<key_type> query(numLookups);
+  for (size_t i = 0; i < query.size(); ++i) {
+    query[i] = static_cast<key_type>(
+        sl::Random::inRange<size_t>(0, universe / 2, rng) * 2);
+  }
+
+  std::vector<value_type> out(query.size());
+  std::unique_ptr<bool[]> found(new bool[query.size()]);
+
+  uint64_t check = 0;
+
+  sl::Timer singleGet;
+  singleGet.start();
+  for (size_t i = 0; i < query.size(); ++i) {
+    out[i] = map.get(query[i]);
+  }
+  singleGet.stop();
+  for (value_type const v : out) {
+    check += v;
+  }
+
+  sl::Timer batchGet;
+  batchGet.start();
+  map.getMany(query.data(), query.size(), out.data());
+  batchGet.stop();
+  for (value_type const v : out) {
+    check -= v;
+  }
+
+  sl::Timer singleHas;
+  singleHas.start();
+  for (size_t i = 0; i < query.size(); ++i) {
+    found[i] = map.has(query[i] + 1);
+  }
+  singleHas.stop();
+
+  sl::Timer batchHas;
+  batchHas.start();
+  map.hasMany(query.data(), query.size(), found.get());
+  batchHas.stop();
+
+  std::cout << "universe: " << universe << ", lookups: " << numLookups << \
+      std::endl;
+  std::cout << "add():     " << singleAdd.poll() << "s" << std::endl;
+  std::cout << "addMany(): " << batchAdd.poll() << "s (" << \
+      singleAdd.poll() / batchAdd.poll() << "x)" << std::endl;
+  std::cout << "get():     " << singleGet.poll() << "s" << std::endl;
+  std::cout << "getMany(): " << batchGet.poll() << "s (" << \
+      singleGet.poll() / batchGet.poll() << "x)" << std::endl;
+  std::cout << "has():     " << singleHas.poll() << "s" << std::endl;
+  std::cout << "hasMany(): " << batchHas.poll() << "s (" << \
+      singleHas.poll() / batchHas.poll() << "x)" << std::endl;
+
+  // prevent the lookups from being optimized away
+  return check == 0 && found[0] ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/**
+* @file FixedPriorityQueue_bench.cpp
+* @brief Benchmarks for the FixedPriorityQueue class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-30
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "FixedPriorityQueue.hpp"
+#include "Timer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+
+using key_type = float;
+using value_type = uint32_t;
+
+
+/**
+* @brief Time the update and pop throughput of a queue of the given arity.
+*
+* @tparam D The arity of the heap.
+* @tparam C The comparator.
+* @param num The number of elements in the queue.
+* @param keys The initial keys.
+* @param deltas The updates to make (num of them).
+* @param updateValues The values to update.
+*/
+template<size_t D, typename C = std::less<key_type>>
+void benchmark(
+    size_t const num,
+    std::vector<key_type> const & keys,
+    std::vector<key_type> const & deltas,
+    std::vector<value_type> const & updateValues)
+{
+  sl::FixedPriorityQueue<key_type, value_type, D, C> pq(num);
+
+  sl::Timer addTimer;
+  addTimer.start();
+  for (size_t i = 0; i < num; ++i) {
+    pq.add(keys[i], static_cast<value_type>(i));
+  }
+  addTimer.stop();
+
+  // compare to building the same queue in bulk
+  sl::Timer buildTimer;
+  {
+    std::vector<value_type> values(num);
+    for (size_t i = 0; i < num; ++i) {
+      values[i] = static_cast<value_type>(i);
+    }
+    sl::FixedPriorityQueue<key_type, value_type, D, C> bulk(num);
+    buildTimer.start();
+    bulk.build(keys.data(), values.data(), num);
+    buildTimer.stop();
+  }
+
+  sl::Timer updateTimer;
+  updateTimer.start();
+  for (size_t i = 0; i < updateValues.size(); ++i) {
+    pq.updateByDelta(deltas[i], updateValues[i]);
+  }
+  updateTimer.stop();
+
+  uint64_t check = 0;
+  sl::Timer popTimer;
+  popTimer.start();
+  while (pq.size() > 0) {
+    check += pq.pop();
+  }
+  popTimer.stop();
+
+  double const nsPerOp = 1.0e9 / static_cast<double>(num);
+  std::cout << "n=" << num << " D=" << D << \
+      (std::is_same<C, std::less<key_type>>::value ? " max" : " min") << \
+      " add: " << addTimer.poll()*nsPerOp << "ns" << \
+      " build: " << buildTimer.poll()*nsPerOp << "ns" << \
+      " update: " << updateTimer.poll()*nsPerOp << "ns" << \
+      " pop: " << popTimer.poll()*nsPerOp << "ns" << \
+      " (" << check % 2 << ")" << std::endl;
+}
+
+
+/**
+* @brief Time updating the neighbors of a popped vertex, where each neighbor
+* is updated four times, either immediately or deferred and flushed before the
+* next pop.
+*
+* @param num The number of elements in the queue.
+* @param keys The initial keys.
+* @param deltas The updates to make.
+* @param updateValues The values to update.
+* @param degree The number of neighbors updated per pop.
+*/
+void benchmarkBatch(
+    size_t const num,
+    std::vector<key_type> const & keys,
+    std::vector<key_type> const & deltas,
+    std::vector<value_type> const & updateValues,
+    size_t const degree)
+{
+  sl::FixedPriorityQueue<key_type, value_type> immediate(num);
+  sl::FixedPriorityQueue<key_type, value_type> deferred(num);
+  for (size_t i = 0; i < num; ++i) {
+    immediate.add(keys[i], static_cast<value_type>(i));
+    deferred.add(keys[i], static_cast<value_type>(i));
+  }
+
+  size_t const rounds = updateValues.size() / degree;
+
+  sl::Timer immediateTimer;
+  immediateTimer.start();
+  for (size_t r = 0; r < rounds; ++r) {
+    for (size_t pass = 0; pass < 4; ++pass) {
+      for (size_t j = r*degree; j < (r+1)*degree; ++j) {
+        immediate.updateByDelta(deltas[j], updateValues[j]);
+      }
+    }
+    value_type const value = immediate.pop();
+    immediate.add(keys[value], value);
+  }
+  immediateTimer.stop();
+
+  sl::Timer deferredTimer;
+  deferredTimer.start();
+  for (size_t r = 0; r < rounds; ++r) {
+    for (size_t pass = 0; pass < 4; ++pass) {
+      for (size_t j = r*degree; j < (r+1)*degree; ++j) {
+        deferred.deferUpdateByDelta(deltas[j], updateValues[j]);
+      }
+    }
+    deferred.flush();
+    value_type const value = deferred.pop();
+    deferred.add(keys[value], value);
+  }
+  deferredTimer.stop();
+
+  double const nsPerOp = 1.0e9 / static_cast<double>(rounds*degree*4);
+  std::cout << "n=" << num << " degree=" << degree << \
+      " immediate: " << immediateTimer.poll()*nsPerOp << "ns" << \
+      " deferred: " << deferredTimer.poll()*nsPerOp << "ns" << \
+      " (" << (immediate.max() == deferred.max()) << ")" << std::endl;
+}
+
+}
+
+
+int main(
+    int argc,
+    char ** argv)
+{
+  // usage: FixedPriorityQueue_bench [size...]
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.emplace_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes = {10000, 1000000, 10000000};
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<key_type> keyDist(0, 1000);
+  std::uniform_real_distribution<key_type> deltaDist(-10, 10);
+
+  for (size_t const num : sizes) {
+    std::vector<key_type> keys(num);
+    std::vector<key_type> deltas(num);
+    std::vector<value_type> updateValues(num);
+    for (size_t i = 0; i < num; ++i) {
+      keys[i] = keyDist(rng);
+      deltas[i] = deltaDist(rng);
+      updateValues[i] = static_cast<value_type>(rng() % num);
+    }
+
+    benchmark<2>(num, keys, deltas, updateValues);
+    benchmark<4>(num, keys, deltas, updateValues);
+    benchmark<8>(num, keys, deltas, updateValues);
+    benchmark<4, std::greater<key_type>>(num, keys, deltas, updateValues);
+
+    for (size_t const degree : {16, 256, 4096}) {
+      if (degree <= num) {
+        benchmarkBatch(num, keys, deltas, updateValues, degree);
+      }
+    }
+  }
+
+  return 0;
+}
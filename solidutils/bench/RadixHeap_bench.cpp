@@ -0,0 +1,217 @@
+/**
+* @file RadixHeap_bench.cpp
+* @brief Benchmarks for the RadixHeap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-13
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+#include "FixedPriorityQueue.hpp"
+#include "RadixHeap.hpp"
+#include "Timer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+using vertex_type = uint32_t;
+using weight_type = uint32_t;
+
+
+/**
+* @brief A random directed graph in compressed sparse row form.
+*/
+struct graph_struct
+{
+  graph_struct(
+      size_t const numVertices,
+      size_t const numEdges) :
+    offsets(numVertices+1),
+    edges(numEdges),
+    weights(numEdges)
+  {
+    // do nothing
+  }
+
+  std::vector<size_t> offsets;
+  std::vector<vertex_type> edges;
+  std::vector<weight_type> weights;
+};
+
+
+/**
+* @brief Generate a random graph.
+*
+* @param numVertices The number of vertices.
+* @param degree The out degree of each vertex.
+* @param maxWeight The maximum edge weight.
+*
+* @return The graph.
+*/
+graph_struct randomGraph(
+    size_t const numVertices,
+    size_t const degree,
+    weight_type const maxWeight)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<vertex_type> vertexDist(0, \
+      static_cast<vertex_type>(numVertices-1));
+  std::uniform_int_distribution<weight_type> weightDist(1, maxWeight);
+
+  graph_struct graph(numVertices, numVertices*degree);
+  for (size_t v = 0; v <= numVertices; ++v) {
+    graph.offsets[v] = v*degree;
+  }
+  for (size_t e = 0; e < graph.edges.size(); ++e) {
+    graph.edges[e] = vertexDist(rng);
+    graph.weights[e] = weightDist(rng);
+  }
+
+  return graph;
+}
+
+
+/**
+* @brief Find the distance to every vertex from the first.
+*
+* @tparam PQ The type of priority queue (ordered by minimum key).
+* @param graph The graph.
+* @param pq The empty priority queue.
+* @param dist The distance to each vertex (output).
+*/
+template<typename PQ>
+void dijkstra(
+    graph_struct const & graph,
+    PQ & pq,
+    std::vector<uint64_t> & dist)
+{
+  uint64_t const infinity = std::numeric_limits<uint64_t>::max();
+  size_t const numVertices = graph.offsets.size()-1;
+
+  dist.assign(numVertices, infinity);
+  std::vector<bool> done(numVertices, false);
+
+  dist[0] = 0;
+  pq.add(0, 0);
+  while (pq.size() > 0) {
+    uint64_t const d = pq.min();
+    vertex_type const u = pq.pop();
+    done[u] = true;
+    for (size_t e = graph.offsets[u]; e < graph.offsets[u+1]; ++e) {
+      vertex_type const v = graph.edges[e];
+      uint64_t const nd = d + graph.weights[e];
+      if (!done[v] && nd < dist[v]) {
+        if (dist[v] == infinity) {
+          pq.add(nd, v);
+        } else {
+          pq.update(nd, v);
+        }
+        dist[v] = nd;
+      }
+    }
+  }
+}
+
+
+/**
+* @brief Time Dijkstra's algorithm with a given priority queue.
+*
+* @tparam PQ The type of priority queue.
+* @param name The name to report.
+* @param graph The graph.
+* @param dist The distance to each vertex (output).
+*/
+template<typename PQ>
+void benchmark(
+    std::string const & name,
+    graph_struct const & graph,
+    std::vector<uint64_t> & dist)
+{
+  size_t const numVertices = graph.offsets.size()-1;
+  PQ pq(static_cast<vertex_type>(numVertices));
+
+  sl::Timer timer;
+  timer.start();
+  dijkstra(graph, pq, dist);
+  timer.stop();
+
+  uint64_t check = 0;
+  for (uint64_t const d : dist) {
+    if (d != std::numeric_limits<uint64_t>::max()) {
+      check += d;
+    }
+  }
+
+  std::cout << "n=" << numVertices << " m=" << graph.edges.size() << " " << \
+      name << ": " << timer.poll() << "s (" << check << ")" << std::endl;
+}
+
+}
+
+
+int main(
+    int argc,
+    char ** argv)
+{
+  // usage: RadixHeap_bench [size...]
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.emplace_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes = {10000, 1000000, 4000000};
+  }
+
+  size_t const degree = 8;
+  weight_type const maxWeight = 1000;
+
+  for (size_t const num : sizes) {
+    graph_struct const graph = randomGraph(num, degree, maxWeight);
+
+    std::vector<uint64_t> heapDist;
+    std::vector<uint64_t> radixDist;
+
+    benchmark<sl::FixedPriorityQueue<uint64_t, vertex_type, 4, \
+        std::greater<uint64_t>>>("FixedPriorityQueue", graph, heapDist);
+    benchmark<sl::RadixHeap<uint64_t, vertex_type>>("RadixHeap", graph, \
+        radixDist);
+
+    if (heapDist != radixDist) {
+      std::cerr << "Distances do not match." << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
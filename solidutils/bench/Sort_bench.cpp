@@ -0,0 +1,455 @@
+/**
+* @file Sort_bench.cpp
+* @brief Benchmarks for the Sort class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-05-04
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+#include "Parallel.hpp"
+#include "Sort.hpp"
+#include "Timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+using key_type = uint32_t;
+using index_type = uint32_t;
+
+
+/**
+* @brief Report the time taken to sort, and check the result.
+*
+* @param name The name of the sort.
+* @param timer The timer.
+* @param keys The sorted keys.
+* @param expected The expected keys.
+*/
+void report(
+    std::string const & name,
+    sl::Timer const & timer,
+    std::vector<key_type> const & keys,
+    std::vector<key_type> const & expected)
+{
+  std::cout << name << ": " << timer.poll() << "s" << \
+      (keys == expected ? "" : " (incorrect)") << std::endl;
+}
+
+}
+
+
+int main(
+    int argc,
+    char ** argv)
+{
+  // usage: Sort_bench [number of keys]
+  size_t const num = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : \
+      100000000ULL;
+
+  std::mt19937 rng(0);
+  std::vector<key_type> input(num);
+  for (key_type & key : input) {
+    key = static_cast<key_type>(rng());
+  }
+
+  std::cout << "n=" << num << std::endl;
+
+  std::vector<key_type> expected(input);
+  {
+    sl::Timer timer;
+    timer.start();
+    std::sort(expected.begin(), expected.end());
+    timer.stop();
+    report("std::sort", timer, expected, expected);
+  }
+
+  std::vector<key_type> keys(num);
+  std::vector<key_type> scratch(num);
+
+  {
+    keys = input;
+    sl::Timer timer;
+    timer.start();
+    sl::Sort::radix<key_type, 8>(keys.data(), num, scratch.data());
+    timer.stop();
+    report("radix 8-bit", timer, keys, expected);
+  }
+
+  {
+    keys = input;
+    sl::Timer timer;
+    timer.start();
+    sl::Sort::radix<key_type, 11>(keys.data(), num, scratch.data());
+    timer.stop();
+    report("radix 11-bit", timer, keys, expected);
+  }
+
+  {
+    keys = input;
+    sl::Timer timer;
+    timer.start();
+    sl::Sort::inPlaceRadix(keys.data(), num);
+    timer.stop();
+    report("in-place radix", timer, keys, expected);
+  }
+
+  {
+    keys = input;
+    std::vector<index_type> index(num);
+    std::vector<index_type> indexScratch(num);
+    sl::Timer timer;
+    timer.start();
+    sl::Sort::radix<key_type, index_type, 8>(keys.data(), index.data(), num, \
+        scratch.data(), indexScratch.data());
+    timer.stop();
+    report("radix 8-bit with index", timer, keys, expected);
+  }
+
+  // sorting key-value pairs, either by generating the permutation and
+  // gathering the values through it, or by moving the values with the keys
+  {
+    std::vector<index_type> values(num);
+    for (size_t i = 0; i < num; ++i) {
+      values[i] = static_cast<index_type>(input[i] * 3);
+    }
+
+    keys = input;
+    std::vector<index_type> index(num);
+    std::vector<index_type> indexScratch(num);
+    std::vector<index_type> gathered(num);
+    sl::Timer gatherTimer;
+    gatherTimer.start();
+    sl::Sort::radix<key_type, index_type, 8>(keys.data(), index.data(), num, \
+        scratch.data(), indexScratch.data());
+    for (size_t i = 0; i < num; ++i) {
+      gathered[i] = values[index[i]];
+    }
+    gatherTimer.stop();
+    report("radix 8-bit pairs (index and gather)", gatherTimer, keys, \
+        expected);
+    indexScratch = std::vector<index_type>();
+    index = std::vector<index_type>();
+
+    std::vector<index_type> valueScratch(num);
+    std::vector<size_t> threadCounts{1};
+    if (sl::Parallel::defaultThreads() > 1) {
+      threadCounts.push_back(sl::Parallel::defaultThreads());
+    }
+    for (size_t const numThreads : threadCounts) {
+      keys = input;
+      std::vector<index_type> carried(values);
+      sl::Timer carryTimer;
+      carryTimer.start();
+      sl::Sort::radixByKey<key_type, index_type, 8>(keys.data(), \
+          carried.data(), num, scratch.data(), valueScratch.data(), \
+          numThreads);
+      carryTimer.stop();
+      report("radix 8-bit pairs (carried, " + std::to_string(numThreads) + \
+          " threads)", carryTimer, keys, expected);
+      if (carried != gathered) {
+        std::cout << "  (values incorrect)" << std::endl;
+      }
+    }
+  }
+
+  // selecting the median and the top 1%
+  {
+    size_t const k = num / 2;
+
+    keys = input;
+    sl::Timer nthTimer;
+    nthTimer.start();
+    std::nth_element(keys.begin(), keys.begin() + k, keys.end());
+    nthTimer.stop();
+    key_type const median = keys[k];
+    std::cout << "std::nth_element: " << nthTimer.poll() << "s" << std::endl;
+
+    keys = input;
+    sl::Timer selectTimer;
+    selectTimer.start();
+    key_type const selected = sl::Sort::select(keys.data(), num, k);
+    selectTimer.stop();
+    std::cout << "select: " << selectTimer.poll() << "s" << \
+        (selected == median ? "" : " (incorrect)") << std::endl;
+
+    sl::Timer keyTimer;
+    keyTimer.start();
+    key_type const selectedKey = sl::Sort::selectKey(input.data(), num, k);
+    keyTimer.stop();
+    std::cout << "selectKey: " << keyTimer.poll() << "s" << \
+        (selectedKey == median ? "" : " (incorrect)") << std::endl;
+
+    size_t const top = num / 100;
+    std::vector<index_type> order(num);
+    sl::Timer partialTimer;
+    partialTimer.start();
+    for (size_t i = 0; i < num; ++i) {
+      order[i] = static_cast<index_type>(i);
+    }
+    std::partial_sort(order.begin(), order.begin() + top, order.end(), \
+        [&input](index_type const a, index_type const b) {
+      return input[a] > input[b] || (input[a] == input[b] && a < b);
+    });
+    partialTimer.stop();
+    std::cout << "std::partial_sort (top 1%): " << partialTimer.poll() << \
+        "s" << std::endl;
+
+    sl::Timer topTimer;
+    topTimer.start();
+    std::unique_ptr<index_type[]> topK = \
+        sl::Sort::partialTopK<key_type, index_type>(input.data(), num, top);
+    topTimer.stop();
+    std::cout << "partialTopK (top 1%): " << topTimer.poll() << "s" << \
+        (std::equal(order.begin(), order.begin() + top, topK.get()) ? "" : \
+        " (incorrect)") << std::endl;
+  }
+
+  // real valued keys, such as edge ratings
+  {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> reals(num);
+    for (float & key : reals) {
+      key = dist(rng);
+    }
+    std::vector<float> sortedReals(reals);
+
+    sl::Timer stdTimer;
+    stdTimer.start();
+    std::sort(sortedReals.begin(), sortedReals.end());
+    stdTimer.stop();
+    std::cout << "float std::sort: " << stdTimer.poll() << "s" << std::endl;
+
+    std::vector<float> realScratch(num);
+    sl::Timer radixTimer;
+    radixTimer.start();
+    sl::Sort::radix(reals.data(), num, realScratch.data());
+    radixTimer.stop();
+    std::cout << "float radix 8-bit: " << radixTimer.poll() << "s" << \
+        (reals == sortedReals ? "" : " (incorrect)") << std::endl;
+  }
+
+  // comparison sort of 64-bit records, scaling with the number of threads
+  {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<double> records(num);
+    for (double & record : records) {
+      record = dist(rng);
+    }
+    std::vector<double> sortedRecords(records);
+
+    sl::Timer stdTimer;
+    stdTimer.start();
+    std::sort(sortedRecords.begin(), sortedRecords.end(), \
+        std::greater<double>());
+    stdTimer.stop();
+    std::cout << "double std::sort: " << stdTimer.poll() << "s" << std::endl;
+
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < sl::Parallel::defaultThreads(); t *= 2) {
+      threadCounts.push_back(t);
+    }
+    threadCounts.push_back(sl::Parallel::defaultThreads());
+    for (size_t const numThreads : threadCounts) {
+      std::vector<double> sampled(records);
+      sl::Timer timer;
+      timer.start();
+      sl::Sort::sample(sampled.data(), num, numThreads, \
+          std::greater<double>());
+      timer.stop();
+      std::cout << "double sample (" << numThreads << " threads): " << \
+          timer.poll() << "s, speedup " << stdTimer.poll() / timer.poll() << \
+          (sampled == sortedRecords ? "" : " (incorrect)") << std::endl;
+    }
+  }
+
+  // many short arrays, as when sorting adjacency lists
+  for (size_t const length : {8, 16, 32, 64, 128, 256, 512}) {
+    size_t const total = std::min(num, static_cast<size_t>(1) << 24);
+    size_t const count = total / length;
+
+    keys = input;
+    sl::Timer stdTimer;
+    stdTimer.start();
+    for (size_t i = 0; i < count; ++i) {
+      std::sort(keys.data() + (i*length), keys.data() + ((i+1)*length));
+    }
+    stdTimer.stop();
+    std::vector<key_type> sorted(keys.begin(), keys.begin() + (count*length));
+
+    keys = input;
+    sl::Timer smallTimer;
+    smallTimer.start();
+    for (size_t i = 0; i < count; ++i) {
+      sl::Sort::small(keys.data() + (i*length), length);
+    }
+    smallTimer.stop();
+    bool correct = std::equal(sorted.begin(), sorted.end(), keys.begin());
+
+    std::vector<index_type> values(count*length);
+    keys = input;
+    sl::Timer pairTimer;
+    pairTimer.start();
+    for (size_t i = 0; i < count; ++i) {
+      sl::Sort::small(keys.data() + (i*length), values.data() + (i*length), \
+          length);
+    }
+    pairTimer.stop();
+    correct = correct && std::equal(sorted.begin(), sorted.end(), \
+        keys.begin());
+
+    std::cout << "length " << length << ": std::sort " << stdTimer.poll() << \
+        "s, small " << smallTimer.poll() << "s, small with values " << \
+        pairTimer.poll() << "s" << (correct ? "" : " (incorrect)") << \
+        std::endl;
+  }
+
+  // the adjacency lists of a graph with a skewed degree distribution
+  {
+    std::vector<index_type> offsets{0};
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    while (offsets.back() < num / 2) {
+      // pareto distributed degrees with a minimum of 2
+      size_t const degree = std::min(static_cast<size_t>( \
+          2.0 / std::pow(1.0 - uniform(rng), 1.0 / 1.2)), num / 100);
+      offsets.push_back(static_cast<index_type>(std::min( \
+          offsets.back() + degree, num / 2)));
+    }
+    size_t const numSegments = offsets.size() - 1;
+    size_t const total = offsets.back();
+    std::cout << "segments=" << numSegments << ", elements=" << total << \
+        std::endl;
+
+    keys = input;
+    sl::Timer stdTimer;
+    stdTimer.start();
+    for (size_t s = 0; s < numSegments; ++s) {
+      std::sort(keys.data() + offsets[s], keys.data() + offsets[s+1]);
+    }
+    stdTimer.stop();
+    std::cout << "segmented std::sort: " << stdTimer.poll() << "s" << \
+        std::endl;
+    std::vector<key_type> sorted(keys.begin(), keys.begin() + total);
+
+    std::vector<size_t> threadCounts{1};
+    if (sl::Parallel::defaultThreads() > 1) {
+      threadCounts.push_back(sl::Parallel::defaultThreads());
+    }
+    for (size_t const numThreads : threadCounts) {
+      keys = input;
+      sl::Timer timer;
+      timer.start();
+      sl::Sort::segmented(offsets.data(), numSegments, keys.data(), \
+          numThreads);
+      timer.stop();
+      std::cout << "segmented (" << numThreads << " threads): " << \
+          timer.poll() << "s" << (std::equal(sorted.begin(), sorted.end(), \
+          keys.begin()) ? "" : " (incorrect)") << std::endl;
+    }
+  }
+
+  // counting sort of keys in [0,num), as used to build CSR structures
+  {
+    std::vector<index_type> bounded(num);
+    for (index_type & key : bounded) {
+      key = static_cast<index_type>(rng() % num);
+    }
+
+    sl::Timer serialTimer;
+    serialTimer.start();
+    std::unique_ptr<index_type[]> serial = \
+        sl::Sort::fixedKeys<index_type, index_type>(bounded.data(), num);
+    serialTimer.stop();
+    std::cout << "fixedKeys: " << serialTimer.poll() << "s" << std::endl;
+
+    size_t const numThreads = sl::Parallel::defaultThreads();
+    sl::Timer parallelTimer;
+    parallelTimer.start();
+    std::unique_ptr<index_type[]> parallel = \
+        sl::Sort::fixedKeys<index_type, index_type>(bounded.data(), num, \
+        numThreads);
+    parallelTimer.stop();
+    std::cout << "fixedKeys (" << numThreads << " threads): " << \
+        parallelTimer.poll() << "s" << \
+        (std::equal(serial.get(), serial.get()+num, parallel.get()) ? "" : \
+        " (incorrect)") << std::endl;
+  }
+
+  // repeatedly bucketing a shrinking set of vertices by partition
+  {
+    size_t const numParts = 64;
+    std::vector<index_type> parts(num);
+    for (index_type & part : parts) {
+      part = static_cast<index_type>(rng() % numParts);
+    }
+
+    sl::Timer fullTimer;
+    fullTimer.start();
+    for (size_t level = num; level > 1000; level /= 2) {
+      std::unique_ptr<index_type[]> perm = \
+          sl::Sort::fixedKeys<index_type, index_type>(parts.data(), level);
+    }
+    fullTimer.stop();
+    std::cout << "fixedKeys per level: " << fullTimer.poll() << "s" << \
+        std::endl;
+
+    sl::Timer boundedTimer;
+    boundedTimer.start();
+    for (size_t level = num; level > 1000; level /= 2) {
+      std::unique_ptr<index_type[]> perm = \
+          sl::Sort::fixedKeysRange<index_type, index_type>(parts.data(), \
+          level, numParts-1);
+    }
+    boundedTimer.stop();
+    std::cout << "fixedKeysRange per level: " << boundedTimer.poll() << \
+        "s" << std::endl;
+
+    sl::FixedKeysWorkspace<index_type> workspace;
+    sl::Timer workspaceTimer;
+    workspaceTimer.start();
+    bool correct = true;
+    for (size_t level = num; level > 1000; level /= 2) {
+      index_type const * const perm = sl::Sort::fixedKeysRange(parts.data(), \
+          level, numParts-1, workspace);
+      correct = correct && perm[level-1] < level;
+    }
+    workspaceTimer.stop();
+    std::cout << "fixedKeysRange with workspace per level: " << \
+        workspaceTimer.poll() << "s" << (correct ? "" : " (incorrect)") << \
+        std::endl;
+  }
+
+  return 0;
+}
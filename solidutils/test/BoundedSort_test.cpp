@@ -0,0 +1,79 @@
+/**
+* @file BoundedSort_test.cpp
+* @brief Unit tests for the BoundedSort class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-05-18
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "BoundedSort.hpp"
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+namespace
+{
+
+template<typename K>
+void checkRadix(
+    size_t const num,
+    uint64_t const max)
+{
+  std::mt19937_64 rng(0);
+
+  std::vector<K> keys(num);
+  for (K & key : keys) {
+    key = static_cast<K>(rng() % max);
+  }
+  std::vector<K> scratch(num);
+  std::vector<K> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  BoundedSort::radix(keys.data(), num, max, scratch.data());
+
+  testTrue(keys == expected);
+}
+
+}
+
+
+UNITTEST(BoundedSort, Radix)
+{
+  checkRadix<uint32_t>(0, 10);
+  checkRadix<uint32_t>(1000, 1);
+  checkRadix<uint8_t>(1000, 256);
+  checkRadix<uint16_t>(5000, 65536);
+  checkRadix<int>(5000, 300);
+  checkRadix<uint64_t>(5000, static_cast<uint64_t>(1) << 40);
+}
+
+
+}
@@ -0,0 +1,272 @@
+/**
+* @file BucketPriorityQueue_test.cpp
+* @brief Unit tests for the BucketPriorityQueue class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-06
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+
+#include "UnitTest.hpp"
+#include "BucketPriorityQueue.hpp"
+#include "FixedPriorityQueue.hpp"
+
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+
+UNITTEST(BucketPriorityQueue, AddPopInOrder)
+{
+  BucketPriorityQueue<int, int> pq(-10, 10, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(10-i, i);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    testEqual(pq.max(), 10-i);
+    testEqual(pq.peek(), i);
+    int const num = pq.pop();
+    testEqual(num, i);
+  }
+
+  testEqual(pq.size(), 0u);
+}
+
+
+UNITTEST(BucketPriorityQueue, NegativeKeys)
+{
+  BucketPriorityQueue<int, int> pq(-10, 10, 10);
+
+  pq.add(-10, 0);
+  pq.add(-3, 1);
+  pq.add(-7, 2);
+
+  int const first = pq.pop();
+  int const second = pq.pop();
+  int const third = pq.pop();
+
+  testEqual(first, 1);
+  testEqual(second, 2);
+  testEqual(third, 0);
+}
+
+
+UNITTEST(BucketPriorityQueue, UpdateByDelta)
+{
+  BucketPriorityQueue<int, int> pq(-20, 20, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(-i, i);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    if (i % 3 == 0) {
+      pq.updateByDelta(2*i, i);
+    }
+  }
+
+  testEqual(pq.max(), 9);
+  testEqual(pq.peek(), 9);
+
+  int last = pq.max();
+  while (pq.size() > 0) {
+    int const key = pq.max();
+    int const x = pq.pop();
+    testLessOrEqual(key, last);
+    if (x % 3 == 0) {
+      testEqual(key, x);
+    } else {
+      testEqual(key, -x);
+    }
+    last = key;
+  }
+}
+
+
+UNITTEST(BucketPriorityQueue, AddRemoveContains)
+{
+  BucketPriorityQueue<int, int> pq(0, 5, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i % 5, i);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    if (i % 3 == 0) {
+      pq.remove(i);
+    }
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    if (i % 3 == 0) {
+      testFalse(pq.contains(i));
+    } else {
+      testTrue(pq.contains(i));
+      testEqual(pq.get(i), i % 5);
+    }
+  }
+}
+
+
+UNITTEST(BucketPriorityQueue, TieBreaking)
+{
+  BucketPriorityQueue<int, int, TieBreaking::LIFO> lifo(0, 2, 4);
+  BucketPriorityQueue<int, int, TieBreaking::FIFO> fifo(0, 2, 4);
+
+  for (int i = 0; i < 4; ++i) {
+    lifo.add(1, i);
+    fifo.add(1, i);
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    int const lifoValue = lifo.pop();
+    int const fifoValue = fifo.pop();
+    testEqual(lifoValue, 3-i);
+    testEqual(fifoValue, i);
+  }
+}
+
+
+UNITTEST(BucketPriorityQueue, Clear)
+{
+  BucketPriorityQueue<int, int, TieBreaking::FIFO> pq(0, 10, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i, i);
+  }
+  pq.pop();
+  pq.clear();
+
+  testEqual(pq.size(), 0u);
+  for (int i = 0; i < 10; ++i) {
+    testFalse(pq.contains(i));
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(10-i, i);
+  }
+  for (int i = 0; i < 10; ++i) {
+    int const num = pq.pop();
+    testEqual(num, i);
+  }
+}
+
+
+UNITTEST(BucketPriorityQueue, RemainingAll)
+{
+  BucketPriorityQueue<int, int> pq(-5, 5, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i - 5, i);
+  }
+  pq.remove(9);
+
+  std::vector<bool> seen(10, false);
+  int last = 5;
+  for (int const value : pq.remaining()) {
+    testFalse(seen[value]);
+    seen[value] = true;
+    testLessOrEqual(pq.get(value), last);
+    last = pq.get(value);
+  }
+
+  for (int i = 0; i < 9; ++i) {
+    testTrue(seen[i]);
+  }
+  testFalse(seen[9]);
+}
+
+
+UNITTEST(BucketPriorityQueue, RemainingAfterClear)
+{
+  BucketPriorityQueue<int, int, TieBreaking::FIFO> pq(0, 10, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i, i);
+  }
+  pq.clear();
+  pq.add(4, 3);
+
+  std::vector<int> values;
+  for (int const value : pq.remaining()) {
+    values.emplace_back(value);
+  }
+
+  testEqual(values.size(), 1u);
+  testEqual(values[0], 3);
+}
+
+
+UNITTEST(BucketPriorityQueue, MatchesFixedPriorityQueue)
+{
+  int const max = 500;
+  int const range = 50;
+
+  std::mt19937 rng(0);
+  BucketPriorityQueue<int, int> bucket(-range, range, max);
+  FixedPriorityQueue<int, int> heap(max);
+
+  for (int i = 0; i < max; ++i) {
+    int const key = static_cast<int>(rng() % (2*range + 1)) - range;
+    bucket.add(key, i);
+    heap.add(key, i);
+  }
+
+  for (int i = 0; i < 2000; ++i) {
+    int const value = static_cast<int>(rng() % max);
+    int const op = static_cast<int>(rng() % 4);
+    if (op == 0 && bucket.size() > 0) {
+      testEqual(bucket.max(), heap.max());
+      int const popped = bucket.pop();
+      heap.remove(popped);
+    } else if (bucket.contains(value)) {
+      if (op == 1) {
+        bucket.remove(value);
+        heap.remove(value);
+      } else {
+        int const key = static_cast<int>(rng() % (2*range + 1)) - range;
+        bucket.update(key, value);
+        heap.update(key, value);
+      }
+    } else {
+      int const key = static_cast<int>(rng() % (2*range + 1)) - range;
+      bucket.add(key, value);
+      heap.add(key, value);
+    }
+
+    testEqual(bucket.size(), heap.size());
+    if (bucket.size() > 0) {
+      testEqual(bucket.max(), heap.max());
+    }
+  }
+}
+
+
+}
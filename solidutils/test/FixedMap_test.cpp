@@ -184,5 +184,118 @@ UNITTEST(FixedMap, Values)
 }
 
 
+UNITTEST(FixedMap, AddManyGetMany)
+{
+  FixedMap<int, float> map(100);
+
+  std::vector<int> keys;
+  std::vector<float> values;
+  for (int i = 0; i < 100; i += 3) {
+    keys.emplace_back((i * 7) % 100);
+    values.emplace_back(static_cast<float>(i));
+  }
+
+  map.addMany(keys.data(), values.data(), keys.size());
+
+  testEqual(map.size(), keys.size());
+
+  std::vector<float> out(keys.size());
+  map.getMany(keys.data(), keys.size(), out.data());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    testEqual(out[i], values[i]);
+    testEqual(map.get(keys[i]), values[i]);
+  }
+}
+
+
+UNITTEST(FixedMap, HasMany)
+{
+  FixedMap<int, float> map(100);
+
+  for (int i = 0; i < 100; i += 2) {
+    map.add(i, 1.0);
+  }
+
+  std::vector<int> keys;
+  for (int i = 99; i >= 0; --i) {
+    keys.emplace_back(i);
+  }
+
+  std::unique_ptr<bool[]> out(new bool[keys.size()]);
+  map.hasMany(keys.data(), keys.size(), out.get());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    testEqual(out[i], keys[i] % 2 == 0);
+  }
+}
+
+
+UNITTEST(FixedMap, SortedKeys)
+{
+  // sparse and dense maps take different paths
+  for (size_t const max : {10000, 20}) {
+    FixedMap<int, float> map(max);
+
+    map.add(12, 1.0);
+    map.add(3, 2.0);
+    map.add(18, 3.0);
+    map.add(0, 4.0);
+
+    Array<int> sorted = map.sortedKeys();
+    testEqual(sorted.size(), 4u);
+    testEqual(sorted[0], 0);
+    testEqual(sorted[1], 3);
+    testEqual(sorted[2], 12);
+    testEqual(sorted[3], 18);
+  }
+}
+
+
+UNITTEST(FixedMap, SortInPlace)
+{
+  for (size_t const max : {10000, 20}) {
+    FixedMap<int, float> map(max);
+
+    map.add(12, 1.0);
+    map.add(3, 2.0);
+    map.add(18, 3.0);
+    map.add(0, 4.0);
+
+    map.sortInPlace();
+
+    ConstArray<int> keys = map.keys();
+    ConstArray<float> values = map.values();
+    testEqual(keys[0], 0);
+    testEqual(keys[1], 3);
+    testEqual(keys[2], 12);
+    testEqual(keys[3], 18);
+    testEqual(values[0], 4.0);
+    testEqual(values[1], 2.0);
+    testEqual(values[2], 1.0);
+    testEqual(values[3], 3.0);
+
+    // make sure the index is still valid
+    testEqual(map.get(12), 1.0);
+    testEqual(map.get(0), 4.0);
+    map.remove(3);
+    testFalse(map.has(3));
+    testEqual(map.get(18), 3.0);
+  }
+}
+
+
+UNITTEST(FixedMap, Accumulate)
+{
+  FixedMap<int, float> map(10);
+
+  map.accumulate(3, 1.0);
+  map.accumulate(5, 2.0);
+  map.accumulate(3, 4.0);
+
+  testEqual(map.size(), 2u);
+  testEqual(map.get(3), 5.0);
+  testEqual(map.get(5), 2.0);
+}
+
+
 }
 
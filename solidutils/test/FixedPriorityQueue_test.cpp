@@ -31,6 +31,13 @@
 #include "UnitTest.hpp"
 #include "FixedPriorityQueue.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
 
 namespace sl
 {
@@ -283,4 +290,344 @@ UNITTEST(FixedPriorityQueue, RemainingHalf)
   testEqual(count, pq.size());
 }
 
+
+UNITTEST(FixedPriorityQueue, RemainingAfterClear)
+{
+  FixedPriorityQueue<float, int> pq(10);
+
+  for (int i = 0; i < 5; ++i) {
+    pq.add(static_cast<float>(i), i*2);
+  }
+  pq.clear();
+  pq.add(1.0f, 3);
+
+  std::vector<int> values;
+  for (int const i : pq.remaining()) {
+    values.emplace_back(i);
+  }
+
+  testEqual(values.size(), 1u);
+  testEqual(values[0], 3);
+}
+
+
+UNITTEST(FixedPriorityQueue, Move)
+{
+  FixedPriorityQueue<float, int> pq(10);
+  for (int i = 0; i < 10; ++i) {
+    pq.add(static_cast<float>(i % 4), i);
+  }
+
+  FixedPriorityQueue<float, int> moved(std::move(pq));
+  moved.update(10.0f, 5);
+  int const top = moved.pop();
+  testEqual(top, 5);
+
+  FixedPriorityQueue<float, int> assigned(1);
+  assigned = std::move(moved);
+  testEqual(assigned.size(), 9u);
+  testEqual(assigned.max(), 3.0f);
+}
+
+
+UNITTEST(FixedPriorityQueue, Drain)
+{
+  int const max = 500;
+
+  std::mt19937 rng(0);
+  std::vector<int> keys(max);
+  FixedPriorityQueue<int, int> pq(max);
+  for (int i = 0; i < max; ++i) {
+    keys[i] = static_cast<int>(rng() % 1000);
+    pq.add(keys[i], i);
+  }
+  pq.remove(7);
+
+  std::vector<int> outKeys(pq.size());
+  std::vector<int> outValues(pq.size());
+  pq.drain(outKeys.data(), outValues.data());
+
+  testEqual(pq.size(), 0u);
+  testEqual(outValues.size(), static_cast<size_t>(max-1));
+  for (size_t i = 0; i < outValues.size(); ++i) {
+    testEqual(outKeys[i], keys[outValues[i]]);
+    if (i > 0) {
+      testLessOrEqual(outKeys[i], outKeys[i-1]);
+    }
+  }
+  for (int i = 0; i < max; ++i) {
+    testFalse(pq.contains(i));
+  }
+
+  // the queue can be re-used
+  pq.add(5, 7);
+  int value;
+  pq.drain(&value);
+  testEqual(value, 7);
+}
+
+
+namespace
+{
+
+template<size_t D>
+void checkRandomOperations()
+{
+  int const max = 1000;
+
+  std::mt19937 rng(0);
+  FixedPriorityQueue<int, int, D> pq(max);
+  std::vector<int> keys(max);
+
+  for (int i = 0; i < max; ++i) {
+    keys[i] = static_cast<int>(rng() % 5000);
+    pq.add(keys[i], i);
+  }
+
+  // randomly update, and remove values
+  for (int i = 0; i < max; ++i) {
+    int const value = static_cast<int>(rng() % max);
+    if (!pq.contains(value)) {
+      continue;
+    }
+    if (rng() % 4 == 0) {
+      pq.remove(value);
+    } else {
+      keys[value] = static_cast<int>(rng() % 5000);
+      pq.update(keys[value], value);
+    }
+  }
+
+  int last = pq.max();
+  while (pq.size() > 0) {
+    int const key = pq.max();
+    int const value = pq.pop();
+    testEqual(key, keys[value]);
+    testLessOrEqual(key, last);
+    testFalse(pq.contains(value));
+    last = key;
+  }
+}
+
+}
+
+
+UNITTEST(FixedPriorityQueue, RandomOperationsBinary)
+{
+  checkRandomOperations<2>();
+}
+
+
+UNITTEST(FixedPriorityQueue, RandomOperationsQuaternary)
+{
+  checkRandomOperations<4>();
+}
+
+
+UNITTEST(FixedPriorityQueue, RandomOperationsOctonary)
+{
+  checkRandomOperations<8>();
+}
+
+
+UNITTEST(FixedPriorityQueue, MinOrderUnsigned)
+{
+  FixedPriorityQueue<unsigned int, int, 4, std::greater<unsigned int>> pq(10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(static_cast<unsigned int>((i * 7) % 10), i);
+  }
+
+  testEqual(pq.min(), 0u);
+  testEqual(pq.peek(), 0);
+
+  pq.update(100u, 0);
+  pq.updateByDelta(5u, 3);
+
+  unsigned int last = pq.min();
+  while (pq.size() > 0) {
+    unsigned int const key = pq.min();
+    int const value = pq.pop();
+    testGreaterOrEqual(key, last);
+    if (value == 0) {
+      testEqual(key, 100u);
+    } else if (value == 3) {
+      testEqual(key, 6u);
+    }
+    last = key;
+  }
+}
+
+
+namespace
+{
+
+struct AbsoluteLess
+{
+  bool operator()(
+      int const a,
+      int const b) const noexcept
+  {
+    return std::abs(a) < std::abs(b);
+  }
+};
+
+}
+
+
+UNITTEST(FixedPriorityQueue, CustomComparator)
+{
+  FixedPriorityQueue<int, int, 2, AbsoluteLess> pq(5);
+
+  pq.add(3, 0);
+  pq.add(-8, 1);
+  pq.add(5, 2);
+  pq.add(-1, 3);
+  pq.add(0, 4);
+
+  std::vector<int> const expected{1, 2, 0, 3, 4};
+  for (int const value : expected) {
+    int const top = pq.pop();
+    testEqual(top, value);
+  }
+}
+
+
+UNITTEST(FixedPriorityQueue, Build)
+{
+  int const max = 1000;
+
+  std::mt19937 rng(0);
+  std::vector<int> keys(max);
+  std::vector<int> values(max);
+  for (int i = 0; i < max; ++i) {
+    keys[i] = static_cast<int>(rng() % 5000);
+    values[i] = max - i - 1;
+  }
+
+  FixedPriorityQueue<int, int> pq(max);
+
+  // add a few before building
+  pq.add(keys[0], values[0]);
+  pq.add(keys[1], values[1]);
+
+  pq.build(keys.data() + 2, values.data() + 2, max - 2);
+
+  testEqual(pq.size(), static_cast<size_t>(max));
+
+  int last = pq.max();
+  while (pq.size() > 0) {
+    int const key = pq.max();
+    int const value = pq.pop();
+    testEqual(key, keys[max - value - 1]);
+    testLessOrEqual(key, last);
+    last = key;
+  }
+}
+
+
+UNITTEST(FixedPriorityQueue, DeferUpdate)
+{
+  int const max = 1000;
+
+  std::mt19937 rng(0);
+  std::vector<int> keys(max);
+  FixedPriorityQueue<int, int> pq(max);
+  for (int i = 0; i < max; ++i) {
+    keys[i] = static_cast<int>(rng() % 10000);
+    pq.add(keys[i], i);
+  }
+
+  // small batches sift each value, and the last batch is large enough to
+  // rebuild the heap
+  for (int const batch : {1, 5, 20, 50, 100, max}) {
+    for (int j = 0; j < batch; ++j) {
+      // few values, so that some are updated more than once
+      int const value = static_cast<int>(rng() % std::min(batch + 1, max));
+      if (!pq.contains(value)) {
+        continue;
+      }
+      int const delta = static_cast<int>(rng() % 20001) - 10000;
+      keys[value] += delta;
+      pq.deferUpdateByDelta(delta, value);
+      testEqual(pq.get(value), keys[value]);
+    }
+    pq.flush();
+
+    // pop a few and check the order
+    int last = pq.max();
+    for (int j = 0; j < 10; ++j) {
+      int const key = pq.max();
+      int const value = pq.pop();
+      testEqual(key, keys[value]);
+      testLessOrEqual(key, last);
+      last = key;
+    }
+  }
+
+  int last = pq.max();
+  while (pq.size() > 0) {
+    int const key = pq.max();
+    int const value = pq.pop();
+    testEqual(key, keys[value]);
+    testLessOrEqual(key, last);
+    last = key;
+  }
+}
+
+
+UNITTEST(FixedPriorityQueue, DeferUpdateMin)
+{
+  int const max = 2000;
+
+  std::mt19937 rng(1);
+  for (size_t round = 0; round < 50; ++round) {
+    std::vector<int> keys(max);
+    FixedPriorityQueue<int, int, 2, std::greater<int>> pq(max);
+    for (int i = 0; i < max; ++i) {
+      keys[i] = static_cast<int>(rng() % 100);
+      pq.add(keys[i], i);
+    }
+
+    int const batch = static_cast<int>(rng() % (max / 8));
+    for (int j = 0; j < batch; ++j) {
+      int const value = static_cast<int>(rng() % max);
+      keys[value] = static_cast<int>(rng() % 100);
+      pq.deferUpdate(keys[value], value);
+    }
+    pq.flush();
+
+    int last = pq.min();
+    while (pq.size() > 0) {
+      int const key = pq.min();
+      int const value = pq.pop();
+      testEqual(key, keys[value]);
+      testGreaterOrEqual(key, last);
+      last = key;
+    }
+  }
+}
+
+
+UNITTEST(FixedPriorityQueue, DeferUpdateClear)
+{
+  FixedPriorityQueue<int, int> pq(10);
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i, i);
+  }
+
+  pq.deferUpdate(20, 0);
+  pq.clear();
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(i, i);
+  }
+  pq.deferUpdate(-1, 9);
+  pq.flush();
+
+  int const top = pq.pop();
+  testEqual(top, 8);
+}
+
+
 }
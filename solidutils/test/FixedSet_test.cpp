@@ -112,4 +112,131 @@ UNITTEST(FixedSet, Iterator)
 }
 
 
+UNITTEST(FixedSet, AddManyHasMany)
+{
+  FixedSet<int> set(100);
+
+  std::vector<int> elements;
+  for (int i = 0; i < 100; i += 3) {
+    elements.emplace_back(i);
+  }
+
+  set.addMany(elements.data(), elements.size());
+
+  testEqual(set.size(), elements.size());
+
+  std::vector<int> query;
+  for (int i = 99; i >= 0; --i) {
+    query.emplace_back(i);
+  }
+
+  std::unique_ptr<bool[]> out(new bool[query.size()]);
+  set.hasMany(query.data(), query.size(), out.get());
+  for (size_t i = 0; i < query.size(); ++i) {
+    testEqual(out[i], query[i] % 3 == 0);
+  }
+}
+
+
+UNITTEST(FixedSet, SortedKeys)
+{
+  // sparse and dense sets take different paths
+  for (size_t const max : {10000, 20}) {
+    FixedSet<int> set(max);
+
+    std::vector<int> base{7, 1, 15, 3, 12, 0, 19};
+    for (int const v : base) {
+      set.add(v);
+    }
+    std::sort(base.begin(), base.end());
+
+    Array<int> sorted = set.sortedKeys();
+    testEqual(sorted.size(), base.size());
+    for (size_t i = 0; i < base.size(); ++i) {
+      testEqual(sorted[i], base[i]);
+    }
+  }
+}
+
+
+UNITTEST(FixedSet, SortInPlace)
+{
+  for (size_t const max : {10000, 20}) {
+    FixedSet<int> set(max);
+
+    std::vector<int> base{7, 1, 15, 3, 12, 0, 19};
+    for (int const v : base) {
+      set.add(v);
+    }
+    set.sortInPlace();
+
+    std::sort(base.begin(), base.end());
+    testTrue(std::equal(set.begin(), set.end(), base.begin()));
+
+    // make sure the index is still valid
+    set.remove(3);
+    set.remove(19);
+    testEqual(set.size(), base.size() - 2);
+    testFalse(set.has(3));
+    testFalse(set.has(19));
+    testTrue(set.has(0));
+    testTrue(set.has(12));
+  }
+}
+
+
+UNITTEST(FixedSet, Clear)
+{
+  FixedSet<int> set(10);
+
+  set.add(3);
+  set.add(7);
+  set.clear();
+
+  testEqual(set.size(), 0u);
+  testFalse(set.has(3));
+  testFalse(set.has(7));
+
+  set.add(7);
+  testTrue(set.has(7));
+}
+
+
+UNITTEST(FixedSet, SetAlgebra)
+{
+  FixedSet<int> a(20);
+  FixedSet<int> b(20);
+  FixedSet<int> out(20);
+
+  for (int const v : {1, 4, 6, 9, 12, 15}) {
+    a.add(v);
+  }
+  for (int const v : {0, 4, 9, 10, 15, 17, 19}) {
+    b.add(v);
+  }
+
+  testEqual(a.intersectionSize(b), 3u);
+  testEqual(b.intersectionSize(a), 3u);
+
+  a.intersect(b, out);
+  Array<int> sorted = out.sortedKeys();
+  testEqual(sorted.size(), 3u);
+  testEqual(sorted[0], 4);
+  testEqual(sorted[1], 9);
+  testEqual(sorted[2], 15);
+
+  a.unite(b, out);
+  sorted = out.sortedKeys();
+  std::vector<int> const unionExpected{0, 1, 4, 6, 9, 10, 12, 15, 17, 19};
+  testEqual(sorted.size(), unionExpected.size());
+  testTrue(std::equal(sorted.begin(), sorted.end(), unionExpected.begin()));
+
+  a.difference(b, out);
+  sorted = out.sortedKeys();
+  std::vector<int> const diffExpected{1, 6, 12};
+  testEqual(sorted.size(), diffExpected.size());
+  testTrue(std::equal(sorted.begin(), sorted.end(), diffExpected.begin()));
+}
+
+
 }
@@ -0,0 +1,163 @@
+/**
+* @file MultiQueue_test.cpp
+* @brief Unit tests for the MultiQueue class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-20
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "UnitTest.hpp"
+#include "MultiQueue.hpp"
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <vector>
+
+
+namespace sl
+{
+
+namespace
+{
+
+using queue_type = MultiQueue<int, int>;
+
+}
+
+
+
+UNITTEST(MultiQueue, AddPopAll)
+{
+  int const max = 1000;
+  queue_type pq(max, 2);
+
+  testEqual(pq.numQueues(), 4u);
+
+  for (int i = 0; i < max; ++i) {
+    pq.add(static_cast<size_t>(i % 2), i, i);
+  }
+  testEqual(pq.size(), static_cast<size_t>(max));
+
+  std::vector<bool> popped(max, false);
+  for (int i = 0; i < max; ++i) {
+    int const value = pq.pop(0);
+    testNotEqual(value, queue_type::NULL_VALUE);
+    testFalse(popped[value]);
+    testFalse(pq.contains(value));
+    popped[value] = true;
+  }
+
+  int const empty = pq.pop(1);
+  testEqual(empty, queue_type::NULL_VALUE);
+  testEqual(pq.size(), 0u);
+}
+
+
+UNITTEST(MultiQueue, SingleQueueIsExact)
+{
+  // with one thread and two queues, each pop takes the better of the two
+  // tops, which is the global top
+  queue_type pq(100, 1, 1);
+
+  for (int i = 0; i < 100; ++i) {
+    pq.add(0, (i * 37) % 100, i);
+  }
+
+  int last = 100;
+  for (int i = 0; i < 100; ++i) {
+    int const value = pq.pop(0);
+    int const key = (value * 37) % 100;
+    testLess(key, last);
+    last = key;
+  }
+}
+
+
+UNITTEST(MultiQueue, UpdateRemove)
+{
+  queue_type pq(10, 1, 1);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(0, i, i);
+  }
+
+  testTrue(pq.update(100, 3));
+  testEqual(pq.get(3), 100);
+  testTrue(pq.remove(9));
+  testFalse(pq.contains(9));
+  testFalse(pq.remove(9));
+  testFalse(pq.update(5, 9));
+
+  int const first = pq.pop(0);
+  testEqual(first, 3);
+
+  pq.clear();
+  testEqual(pq.size(), 0u);
+  for (int i = 0; i < 10; ++i) {
+    testFalse(pq.contains(i));
+  }
+}
+
+
+UNITTEST(MultiQueue, Concurrent)
+{
+  size_t const numThreads = 4;
+  int const max = 20000;
+
+  queue_type pq(max, numThreads);
+  std::vector<std::atomic<int>> popped(max);
+  for (std::atomic<int> & p : popped) {
+    p.store(0);
+  }
+
+  Parallel::run(numThreads, [&pq, &popped, numThreads](size_t const tid) {
+    int const t = static_cast<int>(tid);
+    for (int i = t; i < max; i += static_cast<int>(numThreads)) {
+      pq.add(tid, i, i);
+    }
+    // move some values around
+    for (int i = t; i < max; i += 7*static_cast<int>(numThreads)) {
+      pq.update(-i, i);
+    }
+    for (int i = 0; i < max / static_cast<int>(numThreads); ++i) {
+      int const value = pq.pop(tid);
+      if (value != queue_type::NULL_VALUE) {
+        ++popped[value];
+      }
+    }
+  });
+
+  // pop any left behind
+  while (pq.size() > 0) {
+    int const value = pq.pop(0);
+    ++popped[value];
+  }
+
+  for (int i = 0; i < max; ++i) {
+    testEqual(popped[i].load(), 1);
+  }
+}
+
+
+}
@@ -0,0 +1,83 @@
+/**
+* @file Parallel_test.cpp
+* @brief Unit tests for the Parallel class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-16
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "Parallel.hpp"
+#include "UnitTest.hpp"
+
+#include <atomic>
+#include <vector>
+
+
+namespace sl
+{
+
+
+UNITTEST(Parallel, Run)
+{
+  std::vector<int> ran(5, 0);
+
+  Parallel::run(ran.size(), [&ran](size_t const threadId) {
+    ran[threadId] += 1;
+  });
+
+  for (int const r : ran) {
+    testEqual(r, 1);
+  }
+}
+
+
+UNITTEST(Parallel, ForDynamic)
+{
+  std::vector<int> ran(100, 0);
+  std::atomic<int> total(0);
+
+  Parallel::forDynamic(3, ran.size(), \
+      [&ran, &total](size_t const index, size_t const threadId) {
+    ran[index] += 1;
+    total += static_cast<int>(threadId < 3);
+  });
+
+  for (int const r : ran) {
+    testEqual(r, 1);
+  }
+  testEqual(total.load(), 100);
+}
+
+
+UNITTEST(Parallel, BlockStart)
+{
+  // 10 elements over 3 threads -> 4, 3, 3
+  testEqual(Parallel::blockStart(10, 0, 3), 0u);
+  testEqual(Parallel::blockStart(10, 1, 3), 4u);
+  testEqual(Parallel::blockStart(10, 2, 3), 7u);
+  testEqual(Parallel::blockStart(10, 3, 3), 10u);
+}
+
+
+}
@@ -0,0 +1,165 @@
+/**
+* @file RadixHeap_test.cpp
+* @brief Unit tests for the RadixHeap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-13
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+
+
+#include "UnitTest.hpp"
+#include "RadixHeap.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+
+UNITTEST(RadixHeap, AddPopInOrder)
+{
+  RadixHeap<uint32_t, int> pq(10);
+
+  for (int i = 0; i < 10; ++i) {
+    pq.add(static_cast<uint32_t>(100 + (i*7)), 9-i);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    testEqual(pq.min(), static_cast<uint32_t>(100 + (i*7)));
+    testEqual(pq.peek(), 9-i);
+    int const value = pq.pop();
+    testEqual(value, 9-i);
+    testFalse(pq.contains(value));
+  }
+
+  testEqual(pq.size(), 0u);
+}
+
+
+UNITTEST(RadixHeap, Update)
+{
+  RadixHeap<uint64_t, int> pq(4);
+
+  pq.add(1000, 0);
+  pq.add(2000, 1);
+  pq.add(3000, 2);
+  pq.add(4000, 3);
+
+  int const first = pq.pop();
+  testEqual(first, 0);
+
+  pq.update(1000, 3);
+  pq.update(1500, 2);
+  testEqual(pq.get(3), 1000u);
+  testEqual(pq.get(2), 1500u);
+
+  int const second = pq.pop();
+  int const third = pq.pop();
+  int const fourth = pq.pop();
+  testEqual(second, 3);
+  testEqual(third, 2);
+  testEqual(fourth, 1);
+}
+
+
+UNITTEST(RadixHeap, RemoveAndClear)
+{
+  RadixHeap<uint32_t, int> pq(5);
+
+  for (int i = 0; i < 5; ++i) {
+    pq.add(static_cast<uint32_t>(i*i), i);
+  }
+
+  pq.remove(0);
+  pq.remove(3);
+  testEqual(pq.size(), 3u);
+  testFalse(pq.contains(3));
+
+  int const first = pq.pop();
+  testEqual(first, 1);
+
+  pq.clear();
+  testEqual(pq.size(), 0u);
+  for (int i = 0; i < 5; ++i) {
+    testFalse(pq.contains(i));
+  }
+
+  // the last key popped is reset
+  pq.add(0, 4);
+  testEqual(pq.min(), 0u);
+}
+
+
+UNITTEST(RadixHeap, RandomMonotone)
+{
+  size_t const num = 2000;
+
+  std::mt19937 rng(0);
+  RadixHeap<uint32_t, uint32_t> pq(num);
+  std::vector<uint32_t> keys(num, 0);
+
+  uint32_t last = 0;
+  for (uint32_t v = 0; v < num / 2; ++v) {
+    keys[v] = static_cast<uint32_t>(rng() % 100000);
+    pq.add(keys[v], v);
+  }
+  uint32_t next = static_cast<uint32_t>(num / 2);
+
+  while (pq.size() > 0) {
+    uint32_t const key = pq.min();
+    uint32_t const value = pq.pop();
+    testEqual(key, keys[value]);
+    testGreaterOrEqual(key, last);
+    last = key;
+
+    // check it is the minimum of those remaining
+    for (uint32_t v = 0; v < next; ++v) {
+      if (pq.contains(v)) {
+        testGreaterOrEqual(keys[v], key);
+      }
+    }
+
+    // decrease a random key, and add a new one
+    uint32_t const target = static_cast<uint32_t>(rng() % num);
+    if (pq.contains(target) && keys[target] > key) {
+      keys[target] = key + static_cast<uint32_t>(rng() % \
+          (keys[target] - key));
+      pq.update(keys[target], target);
+    }
+    if (next < num) {
+      keys[next] = key + static_cast<uint32_t>(rng() % 1000);
+      pq.add(keys[next], next);
+      ++next;
+    }
+  }
+}
+
+
+}
@@ -0,0 +1,144 @@
+/**
+* @file SetMath_test.cpp
+* @brief Unit tests for the SetMath class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-09
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "SetMath.hpp"
+#include "UnitTest.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+
+namespace sl
+{
+
+namespace
+{
+
+template<typename T>
+std::vector<T> randomSortedSet(
+    size_t const num,
+    T const max,
+    std::mt19937 & rng)
+{
+  std::vector<T> set;
+  for (size_t i = 0; i < num; ++i) {
+    set.emplace_back(static_cast<T>(rng() % max));
+  }
+  std::sort(set.begin(), set.end());
+  set.erase(std::unique(set.begin(), set.end()), set.end());
+  return set;
+}
+
+template<typename T>
+void checkIntersect(
+    std::vector<T> const & a,
+    std::vector<T> const & b)
+{
+  std::vector<T> expected;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), \
+      std::back_inserter(expected));
+
+  ConstArray<T> arrA(a.data(), a.size());
+  ConstArray<T> arrB(b.data(), b.size());
+  Array<T> out(std::min(a.size(), b.size()));
+
+  size_t const num = SetMath::intersect(arrA, arrB, out);
+  testEqual(num, expected.size());
+  testTrue(std::equal(expected.begin(), expected.end(), out.begin()));
+
+  testEqual(SetMath::intersectionSize(arrA, arrB), expected.size());
+  testEqual(SetMath::intersectionSize(arrB, arrA), expected.size());
+}
+
+}
+
+
+UNITTEST(SetMath, IntersectSmall)
+{
+  std::vector<uint32_t> const a{1, 3, 4, 8, 9, 10, 11, 20, 21};
+  std::vector<uint32_t> const b{0, 3, 8, 10, 11, 12, 13, 14, 21, 22};
+
+  checkIntersect(a, b);
+}
+
+
+UNITTEST(SetMath, IntersectRandom32)
+{
+  std::mt19937 rng(0);
+  for (size_t i = 0; i < 20; ++i) {
+    std::vector<int> const a = randomSortedSet<int>(100 + i, 300, rng);
+    std::vector<int> const b = randomSortedSet<int>(200 - i, 300, rng);
+    checkIntersect(a, b);
+  }
+}
+
+
+UNITTEST(SetMath, IntersectRandom64)
+{
+  std::mt19937 rng(0);
+  for (size_t i = 0; i < 20; ++i) {
+    std::vector<uint64_t> const a = randomSortedSet<uint64_t>(100, 300, rng);
+    std::vector<uint64_t> const b = randomSortedSet<uint64_t>(150, 300, rng);
+    checkIntersect(a, b);
+  }
+}
+
+
+UNITTEST(SetMath, IntersectGallop)
+{
+  std::mt19937 rng(0);
+  std::vector<uint32_t> const large = randomSortedSet<uint32_t>(10000, \
+      20000, rng);
+  std::vector<uint32_t> small = randomSortedSet<uint32_t>(20, 20000, rng);
+  // make sure there is some overlap
+  small.insert(small.end(), large.begin() + 100, large.begin() + 105);
+  small.emplace_back(large.front());
+  small.emplace_back(large.back());
+  std::sort(small.begin(), small.end());
+  small.erase(std::unique(small.begin(), small.end()), small.end());
+
+  checkIntersect(small, large);
+  checkIntersect(large, small);
+}
+
+
+UNITTEST(SetMath, IntersectEmpty)
+{
+  std::vector<uint32_t> const a;
+  std::vector<uint32_t> const b{1, 2, 3, 4, 5};
+
+  checkIntersect(a, b);
+  checkIntersect(b, a);
+}
+
+
+}
@@ -0,0 +1,113 @@
+/**
+* @file ShardedFixedMap_test.cpp
+* @brief Unit tests for the ShardedFixedMap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-16
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "ShardedFixedMap.hpp"
+#include "UnitTest.hpp"
+
+#include <vector>
+
+
+namespace sl
+{
+
+
+UNITTEST(ShardedFixedMap, ReduceArray)
+{
+  size_t const numThreads = 4;
+  size_t const size = 1000;
+
+  ShardedFixedMap<int, int> shards(size, numThreads);
+
+  Parallel::run(numThreads, [&shards](size_t const threadId) {
+    for (int i = 0; i < static_cast<int>(size); i += 3) {
+      shards.add(threadId, i, static_cast<int>(threadId) + 1);
+    }
+  });
+
+  Array<int> totals(size, 1);
+  shards.reduce(totals);
+
+  for (size_t i = 0; i < size; ++i) {
+    if (i % 3 == 0) {
+      // 1 + (1 + 2 + 3 + 4)
+      testEqual(totals[i], 11);
+    } else {
+      testEqual(totals[i], 1);
+    }
+  }
+}
+
+
+UNITTEST(ShardedFixedMap, ReduceFixedMap)
+{
+  size_t const numThreads = 3;
+  size_t const size = 500;
+
+  ShardedFixedMap<int, int> shards(size, numThreads);
+
+  Parallel::run(numThreads, [&shards](size_t const threadId) {
+    // each thread touches an overlapping range of keys
+    int const start = static_cast<int>(threadId) * 100;
+    for (int i = start; i < start + 200; ++i) {
+      shards.add(threadId, i, 1);
+    }
+  });
+
+  FixedMap<int, int> map(size);
+  map.add(0, 10);
+  shards.reduce(map);
+
+  testEqual(map.size(), 400u);
+  testEqual(map.get(0), 11);
+  testEqual(map.get(99), 1);
+  testEqual(map.get(100), 2);
+  testEqual(map.get(250), 2);
+  testEqual(map.get(399), 1);
+  testFalse(map.has(400));
+}
+
+
+UNITTEST(ShardedFixedMap, Clear)
+{
+  ShardedFixedMap<int, int> shards(10, 2);
+
+  shards.add(0, 5, 1);
+  shards.add(1, 5, 1);
+  shards.clear();
+  shards.add(1, 7, 3);
+
+  Array<int> totals(10, 0);
+  shards.reduce(totals);
+
+  testEqual(totals[5], 0);
+  testEqual(totals[7], 3);
+}
+
+
+}
@@ -29,7 +29,15 @@
 #include "Sort.hpp"
 #include "UnitTest.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <functional>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace sl
 {
@@ -79,4 +87,727 @@ UNITTEST(Sort, FixedKeysRandom)
 
 
 
+UNITTEST(Sort, FixedKeysParallel)
+{
+  std::mt19937 rng(0);
+
+  for (size_t const num : {0, 1, 7, 1000, 100000}) {
+    std::vector<uint32_t> keys(num);
+    for (uint32_t & key : keys) {
+      key = static_cast<uint32_t>(rng() % num);
+    }
+
+    std::unique_ptr<size_t[]> expected = Sort::fixedKeys<uint32_t, size_t>( \
+        keys.data(), num);
+    for (size_t const numThreads : {2, 3, 4}) {
+      std::unique_ptr<size_t[]> perm = Sort::fixedKeys<uint32_t, size_t>( \
+          keys.data(), num, numThreads);
+      for (size_t i = 0; i < num; ++i) {
+        testEqual(perm[i], expected[i]);
+      }
+    }
+  }
+}
+
+
+UNITTEST(Sort, FixedKeysMaxKey)
+{
+  std::mt19937 rng(0);
+
+  for (size_t const num : {0, 5, 1000, 100000}) {
+    for (size_t const maxKey : {0, 3, 70000}) {
+      std::vector<uint32_t> keys(num);
+      for (uint32_t & key : keys) {
+        key = static_cast<uint32_t>(rng() % (maxKey+1));
+      }
+
+      std::vector<size_t> expected(num);
+      for (size_t i = 0; i < num; ++i) {
+        expected[i] = i;
+      }
+      std::stable_sort(expected.begin(), expected.end(), \
+          [&keys](size_t const a, size_t const b) {
+        return keys[a] < keys[b];
+      });
+
+      for (size_t const numThreads : {1, 3}) {
+        std::unique_ptr<size_t[]> perm = \
+            Sort::fixedKeysRange<uint32_t, size_t>(keys.data(), num, maxKey, \
+            numThreads);
+        testTrue(std::equal(expected.begin(), expected.end(), perm.get()));
+      }
+    }
+  }
+}
+
+
+UNITTEST(Sort, FixedKeysWorkspace)
+{
+  std::mt19937 rng(0);
+
+  FixedKeysWorkspace<uint32_t> workspace;
+  workspace.reserve(1000, 15);
+  uint32_t const * const reserved = workspace.permutation();
+
+  // shrinking inputs, as when bucketing each level of a hierarchy
+  for (size_t const num : {1000, 300, 20, 0}) {
+    std::vector<int> keys(num);
+    for (int & key : keys) {
+      key = static_cast<int>(rng() % 16);
+    }
+
+    std::unique_ptr<uint32_t[]> expected = \
+        Sort::fixedKeysRange<int, uint32_t>(keys.data(), num, 15);
+    uint32_t const * const perm = Sort::fixedKeysRange(keys.data(), num, 15, \
+        workspace);
+    testEqual(perm, reserved);
+    testTrue(std::equal(perm, perm+num, expected.get()));
+  }
+}
+
+
+UNITTEST(Sort, FixedKeysRandomParallel)
+{
+  size_t const num = 50000;
+
+  std::mt19937 rng(0);
+  std::vector<uint32_t> keys(num);
+  for (uint32_t & key : keys) {
+    // few distinct keys, so each has many indices to shuffle
+    key = static_cast<uint32_t>(rng() % 100);
+  }
+
+  std::mt19937 rng1(1);
+  std::unique_ptr<size_t[]> perm1 = Sort::fixedKeysRandom<uint32_t, size_t>( \
+      keys.data(), num, rng1, 3);
+  std::mt19937 rng2(1);
+  std::unique_ptr<size_t[]> perm2 = Sort::fixedKeysRandom<uint32_t, size_t>( \
+      keys.data(), num, rng2, 3);
+
+  std::vector<bool> seen(num, false);
+  bool sorted = true;
+  bool same = true;
+  for (size_t i = 0; i < num; ++i) {
+    testFalse(seen[perm1[i]]);
+    seen[perm1[i]] = true;
+    if (i > 0 && keys[perm1[i]] < keys[perm1[i-1]]) {
+      sorted = false;
+    }
+    same = same && perm1[i] == perm2[i];
+  }
+  testTrue(sorted);
+  testTrue(same);
+
+  // the indices of equal keys should not all be in order
+  std::unique_ptr<size_t[]> stable = Sort::fixedKeys<uint32_t, size_t>( \
+      keys.data(), num, 3);
+  bool shuffled = false;
+  for (size_t i = 0; i < num; ++i) {
+    shuffled = shuffled || perm1[i] != stable[i];
+  }
+  testTrue(shuffled);
+}
+
+
+UNITTEST(Sort, FixedKeysRandomRange)
+{
+  size_t const num = 20000;
+  size_t const maxKey = 9;
+
+  std::mt19937 rng(0);
+  std::vector<uint32_t> keys(num);
+  for (uint32_t & key : keys) {
+    key = static_cast<uint32_t>(rng() % (maxKey+1));
+  }
+
+  std::unique_ptr<size_t[]> stable = Sort::fixedKeysRange<uint32_t, size_t>( \
+      keys.data(), num, maxKey);
+
+  for (size_t const numThreads : {1, 3}) {
+    std::unique_ptr<size_t[]> perm = \
+        Sort::fixedKeysRandomRange<uint32_t, size_t>(keys.data(), num, \
+        maxKey, rng, numThreads);
+
+    std::vector<bool> seen(num, false);
+    bool sorted = true;
+    bool shuffled = false;
+    for (size_t i = 0; i < num; ++i) {
+      testFalse(seen[perm[i]]);
+      seen[perm[i]] = true;
+      if (i > 0 && keys[perm[i]] < keys[perm[i-1]]) {
+        sorted = false;
+      }
+      shuffled = shuffled || perm[i] != stable[i];
+    }
+    testTrue(sorted);
+    testTrue(shuffled);
+  }
+}
+
+
+namespace
+{
+
+struct payload_struct
+{
+  uint32_t position;
+  int16_t tag;
+};
+
+
+template<typename K, size_t BITS>
+void checkRadix(
+    std::vector<K> const & input)
+{
+  std::vector<K> expected(input);
+  std::stable_sort(expected.begin(), expected.end());
+
+  for (size_t const threads : {1, 3}) {
+    std::vector<K> keys(input);
+    std::vector<K> scratch(keys.size());
+    Sort::radix<K, BITS>(keys.data(), keys.size(), scratch.data(), threads);
+    testTrue(keys == expected);
+
+    // the index variant must be stable
+    keys = input;
+    std::vector<uint32_t> index(keys.size());
+    std::vector<uint32_t> indexScratch(keys.size());
+    Sort::radix<K, uint32_t, BITS>(keys.data(), index.data(), keys.size(), \
+        scratch.data(), indexScratch.data(), threads);
+    testTrue(keys == expected);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      testEqual(input[index[i]], keys[i]);
+      if (i > 0 && keys[i] == keys[i-1]) {
+        testGreater(index[i], index[i-1]);
+      }
+    }
+
+    // as must the key-value variant, which should carry the payload with
+    // each key
+    keys = input;
+    std::vector<payload_struct> values(keys.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i].position = static_cast<uint32_t>(i);
+      values[i].tag = static_cast<int16_t>(input[i] % 7);
+    }
+    std::vector<payload_struct> valueScratch(keys.size());
+    Sort::radixByKey<K, payload_struct, BITS>(keys.data(), values.data(), \
+        keys.size(), scratch.data(), valueScratch.data(), threads);
+    testTrue(keys == expected);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      testEqual(values[i].position, index[i]);
+      testEqual(values[i].tag, static_cast<int16_t>(keys[i] % 7));
+    }
+  }
+}
+
+
+template<typename K>
+void checkRadixRandom(
+    uint64_t const range)
+{
+  std::mt19937_64 rng(0);
+
+  std::vector<K> keys(2000);
+  for (K & key : keys) {
+    key = static_cast<K>(rng() % range);
+  }
+
+  checkRadix<K, 8>(keys);
+  checkRadix<K, 11>(keys);
+}
+
+}
+
+
+UNITTEST(Sort, RadixUnsigned)
+{
+  checkRadixRandom<uint8_t>(256);
+  checkRadixRandom<uint16_t>(65536);
+  checkRadixRandom<uint32_t>(1000);
+  checkRadixRandom<uint32_t>(UINT32_MAX);
+  checkRadixRandom<uint64_t>(UINT64_MAX);
+}
+
+
+UNITTEST(Sort, RadixSigned)
+{
+  std::vector<int32_t> keys{5, -3, 0, INT32_MIN, INT32_MAX, -1, 1, -3, 7};
+  checkRadix<int32_t, 8>(keys);
+  checkRadix<int32_t, 11>(keys);
+
+  std::vector<int64_t> wide{-5, 1LL << 40, -(1LL << 40), 0, 3, INT64_MIN};
+  checkRadix<int64_t, 8>(wide);
+
+  std::vector<int8_t> narrow{-128, 127, 0, -1, 1, 5, -5};
+  checkRadix<int8_t, 8>(narrow);
+}
+
+
+UNITTEST(Sort, RadixConstant)
+{
+  // every pass is skipped
+  checkRadix<uint32_t, 8>(std::vector<uint32_t>(100, 77));
+  checkRadix<uint32_t, 8>(std::vector<uint32_t>());
+}
+
+
+UNITTEST(Sort, RadixParallel)
+{
+  std::mt19937 rng(0);
+
+  std::vector<uint32_t> keys(100000);
+  for (uint32_t & key : keys) {
+    key = rng() % 5000;
+  }
+  std::vector<uint32_t> scratch(keys.size());
+
+  std::vector<uint32_t> serialKeys(keys);
+  std::vector<uint32_t> serialValues(keys.size());
+  for (size_t i = 0; i < serialValues.size(); ++i) {
+    serialValues[i] = static_cast<uint32_t>(i);
+  }
+  std::vector<uint32_t> parallelValues(serialValues);
+  std::vector<uint32_t> valueScratch(keys.size());
+  Sort::radixByKey<uint32_t, uint32_t, 11>(serialKeys.data(), \
+      serialValues.data(), keys.size(), scratch.data(), valueScratch.data());
+
+  for (size_t threads = 2; threads <= 4; ++threads) {
+    std::vector<uint32_t> parallelKeys(keys);
+    for (size_t i = 0; i < parallelValues.size(); ++i) {
+      parallelValues[i] = static_cast<uint32_t>(i);
+    }
+    Sort::radixByKey<uint32_t, uint32_t, 11>(parallelKeys.data(), \
+        parallelValues.data(), keys.size(), scratch.data(), \
+        valueScratch.data(), threads);
+    testTrue(parallelKeys == serialKeys);
+    testTrue(parallelValues == serialValues);
+  }
+}
+
+
+
+UNITTEST(Sort, Small)
+{
+  std::mt19937 rng(0);
+
+  std::vector<uint32_t> keys(100);
+  std::vector<uint32_t> values(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = rng() % 50;
+    values[i] = keys[i] * 2;
+  }
+  std::vector<uint32_t> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  std::vector<uint32_t> copy(keys);
+  Sort::small(copy.data(), copy.size());
+  testTrue(copy == expected);
+
+  Sort::small(keys.data(), values.data(), keys.size());
+  testTrue(keys == expected);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    testEqual(values[i], keys[i] * 2);
+  }
+}
+
+
+namespace
+{
+
+template<typename K>
+void checkSegmented(
+    std::vector<uint32_t> const & offsets,
+    std::vector<K> const & input,
+    size_t const numThreads)
+{
+  size_t const numSegments = offsets.size() - 1;
+
+  std::vector<K> expected(input);
+  for (size_t s = 0; s < numSegments; ++s) {
+    std::sort(expected.begin() + offsets[s], expected.begin() + offsets[s+1]);
+  }
+
+  std::vector<K> keys(input);
+  Sort::segmented(offsets.data(), numSegments, keys.data(), numThreads);
+  testTrue(keys == expected);
+
+  // each value is the position of its key, and must stay in its segment
+  keys = input;
+  std::vector<uint32_t> values(keys.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<uint32_t>(i);
+  }
+  Sort::segmented(offsets.data(), numSegments, keys.data(), values.data(), \
+      numThreads);
+  testTrue(keys == expected);
+  for (size_t s = 0; s < numSegments; ++s) {
+    for (uint32_t i = offsets[s]; i < offsets[s+1]; ++i) {
+      testEqual(input[values[i]], keys[i]);
+      testGreaterOrEqual(values[i], offsets[s]);
+      testLess(values[i], offsets[s+1]);
+    }
+  }
+}
+
+}
+
+
+UNITTEST(Sort, Segmented)
+{
+  std::mt19937 rng(0);
+
+  // mostly short segments, with some empty, some long, and one very long
+  std::vector<uint32_t> offsets{0};
+  for (size_t s = 0; s < 2000; ++s) {
+    uint32_t length = rng() % 40;
+    if (s % 97 == 0) {
+      length = 0;
+    } else if (s % 101 == 0) {
+      length = 500 + (rng() % 3000);
+    } else if (s == 1000) {
+      length = 60000;
+    }
+    offsets.push_back(offsets.back() + length);
+  }
+
+  std::vector<uint32_t> keys(offsets.back());
+  for (uint32_t & key : keys) {
+    key = rng() % 100000;
+  }
+  std::vector<float> reals(keys.size());
+  for (size_t i = 0; i < reals.size(); ++i) {
+    reals[i] = static_cast<float>(keys[i]) / 3.0f - 1000.0f;
+  }
+
+  for (size_t const threads : {1, 3}) {
+    checkSegmented(offsets, keys, threads);
+    checkSegmented(offsets, reals, threads);
+  }
+
+  // no segments
+  checkSegmented(std::vector<uint32_t>{0}, std::vector<uint32_t>(), 2);
+}
+
+
+namespace
+{
+
+template<typename K>
+bool floatLess(
+    K const a,
+    K const b)
+{
+  if (std::isnan(a)) {
+    return false;
+  } else if (std::isnan(b)) {
+    return true;
+  } else if (a == b) {
+    return std::signbit(a) && !std::signbit(b);
+  } else {
+    return a < b;
+  }
+}
+
+
+template<typename K>
+bool sameBits(
+    std::vector<K> const & a,
+    std::vector<K> const & b)
+{
+  // empty vectors may have null data, which memcmp must not be given
+  return a.size() == b.size() && (a.empty() || \
+      std::memcmp(a.data(), b.data(), a.size()*sizeof(K)) == 0);
+}
+
+
+template<typename K>
+void checkRadixFloat()
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<K> dist(-1000, 1000);
+
+  std::vector<K> const special{0.0, -0.0, \
+      std::numeric_limits<K>::infinity(), \
+      -std::numeric_limits<K>::infinity(), \
+      std::numeric_limits<K>::quiet_NaN(), \
+      -std::numeric_limits<K>::quiet_NaN(), \
+      std::numeric_limits<K>::denorm_min(), \
+      -std::numeric_limits<K>::denorm_min(), \
+      std::numeric_limits<K>::max(), std::numeric_limits<K>::lowest(), \
+      1.5, -1.5};
+
+  std::vector<K> input(3000);
+  for (K & key : input) {
+    key = rng() % 4 == 0 ? special[rng() % special.size()] : dist(rng);
+  }
+
+  std::vector<uint32_t> order(input.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = static_cast<uint32_t>(i);
+  }
+  std::stable_sort(order.begin(), order.end(), \
+      [&input](uint32_t const a, uint32_t const b) {
+    return floatLess(input[a], input[b]);
+  });
+  std::vector<K> expected(input.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    expected[i] = input[order[i]];
+  }
+
+  for (size_t const threads : {1, 2}) {
+    std::vector<K> keys(input);
+    std::vector<K> scratch(keys.size());
+    Sort::radix(keys.data(), keys.size(), scratch.data(), threads);
+    testTrue(sameBits(keys, expected));
+
+    std::unique_ptr<uint32_t[]> perm = Sort::radixPermutation<K, uint32_t>( \
+        input.data(), input.size(), threads);
+    testTrue(std::equal(order.begin(), order.end(), perm.get()));
+  }
+}
+
+}
+
+
+UNITTEST(Sort, RadixFloat)
+{
+  checkRadixFloat<float>();
+  checkRadixFloat<double>();
+}
+
+
+UNITTEST(Sort, RadixPermutation)
+{
+  std::vector<int64_t> keys{5, -3, 1LL << 40, 5, -3, 0};
+  std::unique_ptr<uint8_t[]> perm = Sort::radixPermutation<int64_t, uint8_t>( \
+      keys.data(), keys.size());
+  std::vector<uint8_t> const expected{1, 4, 5, 0, 3, 2};
+  testTrue(std::equal(expected.begin(), expected.end(), perm.get()));
+}
+
+
+namespace
+{
+
+template<typename K>
+void checkInPlaceRadix(
+    std::vector<K> const & input)
+{
+  // the radix sort defines the order, including for floating point keys
+  std::vector<K> expected(input);
+  std::vector<K> scratch(input.size());
+  Sort::radix(expected.data(), expected.size(), scratch.data());
+
+  for (size_t const threads : {1, 3}) {
+    std::vector<K> keys(input);
+    Sort::inPlaceRadix(keys.data(), keys.size(), threads);
+    testTrue(sameBits(keys, expected));
+
+    keys = input;
+    std::vector<uint32_t> values(keys.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<uint32_t>(i);
+    }
+    Sort::inPlaceRadixByKey(keys.data(), values.data(), keys.size(), threads);
+    testTrue(sameBits(keys, expected));
+    std::vector<bool> seen(values.size(), false);
+    for (size_t i = 0; i < values.size(); ++i) {
+      testEqual(std::memcmp(&input[values[i]], &keys[i], sizeof(K)), 0);
+      testFalse(seen[values[i]]);
+      seen[values[i]] = true;
+    }
+  }
+}
+
+
+template<typename K>
+std::vector<K> randomKeys(
+    size_t const num,
+    uint64_t const range,
+    int64_t const base)
+{
+  std::mt19937_64 rng(0);
+  std::vector<K> keys(num);
+  for (K & key : keys) {
+    key = static_cast<K>(base + (rng() % range));
+  }
+  return keys;
+}
+
+}
+
+
+UNITTEST(Sort, InPlaceRadix)
+{
+  checkInPlaceRadix(randomKeys<uint32_t>(100000, UINT32_MAX, 0));
+  checkInPlaceRadix(randomKeys<uint64_t>(50000, UINT64_MAX, 0));
+  checkInPlaceRadix(randomKeys<int32_t>(50000, UINT32_MAX, 0));
+  checkInPlaceRadix(randomKeys<int16_t>(20000, 1000, -500));
+  checkInPlaceRadix(randomKeys<uint8_t>(5000, 256, 0));
+
+  // all keys share their high digits
+  checkInPlaceRadix(randomKeys<uint64_t>(50000, 5000, 1ULL << 50));
+
+  // few distinct keys, and all equal
+  checkInPlaceRadix(randomKeys<uint32_t>(50000, 3, 7));
+  checkInPlaceRadix(std::vector<uint32_t>(5000, 42));
+  checkInPlaceRadix(std::vector<uint32_t>());
+  checkInPlaceRadix(randomKeys<uint32_t>(20, 100, 0));
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> dist(-1000, 1000);
+  std::vector<double> const special{0.0, -0.0, \
+      std::numeric_limits<double>::infinity(), \
+      -std::numeric_limits<double>::infinity(), \
+      std::numeric_limits<double>::quiet_NaN(), \
+      std::numeric_limits<double>::denorm_min()};
+  std::vector<double> reals(30000);
+  for (double & key : reals) {
+    key = rng() % 8 == 0 ? special[rng() % special.size()] : dist(rng);
+  }
+  checkInPlaceRadix(reals);
+}
+
+
+UNITTEST(Sort, Select)
+{
+  std::mt19937 rng(0);
+
+  for (size_t const num : {1, 2, 10, 1000, 50000}) {
+    std::vector<int> input(num);
+    for (int & value : input) {
+      value = static_cast<int>(rng() % (num / 2 + 1));
+    }
+    std::vector<int> sorted(input);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (size_t const k : {static_cast<size_t>(0), num / 3, num - 1}) {
+      std::vector<int> data(input);
+      int const selected = Sort::select(data.data(), num, k);
+      testEqual(selected, sorted[k]);
+      testEqual(data[k], sorted[k]);
+      for (size_t i = 0; i < k; ++i) {
+        testLessOrEqual(data[i], data[k]);
+      }
+      for (size_t i = k+1; i < num; ++i) {
+        testGreaterOrEqual(data[i], data[k]);
+      }
+    }
+  }
+
+  // with a comparator, and already sorted input
+  std::vector<double> data(10000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<double>(i);
+  }
+  double const selected = Sort::select(data.data(), data.size(), 10, \
+      std::greater<double>());
+  testEqual(selected, 9989.0);
+}
+
+
+namespace
+{
+
+template<typename K>
+void checkSelectKey(
+    std::vector<K> const & keys)
+{
+  std::vector<K> sorted(keys);
+  std::vector<K> scratch(keys.size());
+  Sort::radix(sorted.data(), sorted.size(), scratch.data());
+
+  for (size_t const threads : {1, 3}) {
+    for (size_t const k : {static_cast<size_t>(0), keys.size() / 7, \
+        keys.size() / 2, keys.size() - 1}) {
+      K const selected = Sort::selectKey(keys.data(), keys.size(), k, \
+          threads);
+      testEqual(std::memcmp(&selected, &sorted[k], sizeof(K)), 0);
+    }
+  }
+}
+
+}
+
+
+UNITTEST(Sort, SelectKey)
+{
+  checkSelectKey(randomKeys<uint32_t>(100000, UINT32_MAX, 0));
+  checkSelectKey(randomKeys<int64_t>(50000, 1000, -500));
+  checkSelectKey(randomKeys<uint64_t>(50000, 5000, 1LL << 50));
+  checkSelectKey(randomKeys<uint8_t>(5000, 256, 0));
+  checkSelectKey(randomKeys<uint16_t>(5000, 65536, 0));
+  checkSelectKey(std::vector<uint32_t>(5000, 3));
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-10, 10);
+  std::vector<float> reals(20000);
+  for (float & key : reals) {
+    key = rng() % 50 == 0 ? std::numeric_limits<float>::quiet_NaN() : \
+        dist(rng);
+  }
+  checkSelectKey(reals);
+}
+
+
+UNITTEST(Sort, PartialTopK)
+{
+  std::vector<uint32_t> keys = randomKeys<uint32_t>(50000, 2000, 0);
+
+  std::vector<uint32_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = static_cast<uint32_t>(i);
+  }
+  std::stable_sort(order.begin(), order.end(), \
+      [&keys](uint32_t const a, uint32_t const b) {
+    return keys[a] > keys[b];
+  });
+
+  for (size_t const threads : {1, 3}) {
+    for (size_t const k : {static_cast<size_t>(0), static_cast<size_t>(1), \
+        static_cast<size_t>(500), keys.size()}) {
+      std::unique_ptr<uint32_t[]> top = \
+          Sort::partialTopK<uint32_t, uint32_t>(keys.data(), keys.size(), k, \
+          threads);
+      testTrue(std::equal(order.begin(), order.begin() + k, top.get()));
+    }
+  }
+}
+
+
+UNITTEST(Sort, Sample)
+{
+  for (size_t const num : {static_cast<size_t>(0), static_cast<size_t>(100), \
+      static_cast<size_t>(100000)}) {
+    for (uint32_t const range : {3u, 1000000u}) {
+      std::vector<uint32_t> input = randomKeys<uint32_t>(num, range, 0);
+      std::vector<uint32_t> expected(input);
+      std::sort(expected.begin(), expected.end(), std::greater<uint32_t>());
+
+      for (size_t const threads : {1, 3, 8}) {
+        std::vector<uint32_t> keys(input);
+        Sort::sample(keys.data(), keys.size(), threads, \
+            std::greater<uint32_t>());
+        testTrue(keys == expected);
+      }
+    }
+  }
+}
+
+
+UNITTEST(Sort, SampleStrings)
+{
+  std::vector<uint32_t> input = randomKeys<uint32_t>(50000, 5000, 0);
+  std::vector<std::string> strings(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    strings[i] = std::to_string(input[i]);
+  }
+  std::vector<std::string> expected(strings);
+  std::sort(expected.begin(), expected.end());
+
+  Sort::sample(strings.data(), strings.size(), 4);
+  testTrue(strings == expected);
+}
+
 }
@@ -0,0 +1,141 @@
+/**
+* @file SortingNetwork_test.cpp
+* @brief Unit tests for the SortingNetwork class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-05-11
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "SortingNetwork.hpp"
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+namespace
+{
+
+template<typename K>
+void checkSort(
+    size_t const num,
+    uint64_t const range,
+    std::mt19937 & rng)
+{
+  std::vector<K> input(num);
+  for (K & key : input) {
+    key = static_cast<K>(static_cast<int64_t>(rng() % range) - \
+        static_cast<int64_t>(std::is_signed<K>::value ? range / 2 : 0));
+  }
+
+  std::vector<K> expected(input);
+  std::sort(expected.begin(), expected.end());
+
+  std::vector<K> keys(input);
+  SortingNetwork::sort(keys.data(), keys.size());
+  testTrue(keys == expected);
+
+  // each value is the position of its key, so every pair must survive
+  keys = input;
+  std::vector<uint32_t> values(num);
+  for (size_t i = 0; i < num; ++i) {
+    values[i] = static_cast<uint32_t>(i);
+  }
+  SortingNetwork::sort(keys.data(), values.data(), keys.size());
+  testTrue(keys == expected);
+  std::vector<bool> seen(num, false);
+  for (size_t i = 0; i < num; ++i) {
+    testEqual(input[values[i]], keys[i]);
+    testFalse(seen[values[i]]);
+    seen[values[i]] = true;
+  }
+}
+
+
+template<typename K>
+void checkSizes(
+    uint64_t const range)
+{
+  std::mt19937 rng(0);
+  for (size_t num = 0; num <= 2*SortingNetwork::MAX_SIZE; \
+      num += (num < 200 ? 1 : 37)) {
+    checkSort<K>(num, range, rng);
+  }
+}
+
+}
+
+
+UNITTEST(SortingNetwork, Int32)
+{
+  checkSizes<int32_t>(UINT32_MAX);
+  checkSizes<int32_t>(5);
+}
+
+
+UNITTEST(SortingNetwork, UInt32)
+{
+  checkSizes<uint32_t>(UINT32_MAX);
+  checkSizes<uint32_t>(3);
+}
+
+
+UNITTEST(SortingNetwork, Extremes)
+{
+  std::mt19937 rng(0);
+  std::vector<uint32_t> choices{0, 1, INT32_MAX, \
+      static_cast<uint32_t>(INT32_MAX)+1, UINT32_MAX};
+  std::vector<uint32_t> keys(300);
+  for (uint32_t & key : keys) {
+    key = choices[rng() % choices.size()];
+  }
+  std::vector<uint32_t> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  SortingNetwork::sort(keys.data(), keys.size());
+  testTrue(keys == expected);
+}
+
+
+UNITTEST(SortingNetwork, OtherTypes)
+{
+  checkSizes<uint64_t>(UINT64_MAX);
+  checkSizes<int16_t>(1000);
+
+  std::mt19937 rng(0);
+  std::vector<double> keys(100);
+  for (double & key : keys) {
+    key = static_cast<double>(rng()) / 7.0;
+  }
+  std::vector<double> expected(keys);
+  std::sort(expected.begin(), expected.end());
+  SortingNetwork::sort(keys.data(), keys.size());
+  testTrue(keys == expected);
+}
+
+
+}
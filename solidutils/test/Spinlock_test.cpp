@@ -0,0 +1,69 @@
+/**
+* @file Spinlock_test.cpp
+* @brief Unit tests for the Spinlock class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-20
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#include "UnitTest.hpp"
+#include "Spinlock.hpp"
+#include "Parallel.hpp"
+
+#include <mutex>
+
+
+namespace sl
+{
+
+
+UNITTEST(Spinlock, TryLock)
+{
+  Spinlock lock;
+
+  testTrue(lock.try_lock());
+  testFalse(lock.try_lock());
+  lock.unlock();
+  testTrue(lock.try_lock());
+  lock.unlock();
+}
+
+
+UNITTEST(Spinlock, MutualExclusion)
+{
+  Spinlock lock;
+  size_t count = 0;
+
+  Parallel::run(4, [&lock, &count](size_t) {
+    for (int i = 0; i < 10000; ++i) {
+      std::lock_guard<Spinlock> guard(lock);
+      ++count;
+    }
+  });
+
+  testEqual(count, 40000u);
+}
+
+
+}
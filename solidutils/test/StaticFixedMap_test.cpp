@@ -0,0 +1,116 @@
+/**
+* @file StaticFixedMap_test.cpp
+* @brief Unit tests for the StaticFixedMap class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-23
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+
+#include "StaticFixedMap.hpp"
+#include "UnitTest.hpp"
+
+#include <type_traits>
+
+
+namespace sl
+{
+
+#if !defined(__GNUC__) || defined(__clang__) || __GNUC__ >= 5
+static_assert(std::is_trivially_copyable< \
+    StaticFixedMap<int, float, 64>>::value, \
+    "StaticFixedMap should be trivially copyable.");
+#endif
+
+UNITTEST(StaticFixedMap, AddGetRemove)
+{
+  StaticFixedMap<int, float, 10> map;
+
+  map.add(0, 1.0);
+  map.add(2, 2.0);
+  map.add(5, 0.0);
+
+  testEqual(map.size(), 3u);
+  testEqual(map.get(0), 1.0);
+  testEqual(map.get(2), 2.0);
+  testEqual(map.get(5), 0.0);
+
+  map.remove(0);
+
+  testEqual(map.size(), 2u);
+  testFalse(map.has(0));
+  testEqual(map.get(2), 2.0);
+  testEqual(map.get(5), 0.0);
+}
+
+UNITTEST(StaticFixedMap, Accumulate)
+{
+  StaticFixedMap<int, int, 300> map;
+
+  map.accumulate(299, 2);
+  map.accumulate(7, 1);
+  map.accumulate(299, 3);
+
+  testEqual(map.size(), 2u);
+  testEqual(map.get(299), 5);
+  testEqual(map.get(7), 1);
+}
+
+UNITTEST(StaticFixedMap, KeysValues)
+{
+  StaticFixedMap<int, float, 10> map;
+
+  map.add(0, 1.0);
+  map.add(2, 2.0);
+  map.add(5, 3.0);
+
+  int keySum = 0;
+  for (int const key : map.keys()) {
+    keySum += key;
+  }
+  float valueSum = 0;
+  for (float const value : map.values()) {
+    valueSum += value;
+  }
+
+  testEqual(keySum, 7);
+  testNearEqual(valueSum, 6.0, 1e-9, 1e-9);
+}
+
+UNITTEST(StaticFixedMap, CopyClear)
+{
+  StaticFixedMap<int, float, 10> map;
+  map.add(4, 1.0);
+
+  StaticFixedMap<int, float, 10> copy = map;
+  map.clear();
+
+  testFalse(map.has(4));
+  testTrue(copy.has(4));
+  testEqual(copy.get(4), 1.0);
+}
+
+
+}
@@ -0,0 +1,128 @@
+/**
+* @file StaticFixedSet_test.cpp
+* @brief Unit tests for the StaticFixedSet class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-03-23
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+
+#include "StaticFixedSet.hpp"
+#include "UnitTest.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+
+namespace sl
+{
+
+#if !defined(__GNUC__) || defined(__clang__) || __GNUC__ >= 5
+static_assert(std::is_trivially_copyable<StaticFixedSet<int, 64>>::value, \
+    "StaticFixedSet should be trivially copyable.");
+#endif
+static_assert(sizeof(StaticFixedSet<int, 64>::index_type) == 1, \
+    "Small sets should use a one byte index.");
+
+UNITTEST(StaticFixedSet, SizeAddRemove)
+{
+  StaticFixedSet<int, 10> set;
+
+  testEqual(set.size(), 0u);
+
+  set.add(2);
+  set.add(6);
+
+  testEqual(set.size(), 2u);
+
+  set.remove(6);
+
+  testEqual(set.size(), 1u);
+
+  set.remove(2);
+
+  testEqual(set.size(), 0u);
+}
+
+UNITTEST(StaticFixedSet, HasAddRemove)
+{
+  StaticFixedSet<int, 10> set;
+
+  set.add(0);
+  set.add(2);
+  set.add(5);
+
+  testTrue(set.has(0));
+  testTrue(set.has(2));
+  testTrue(set.has(5));
+  testFalse(set.has(3));
+
+  set.remove(2);
+
+  testTrue(set.has(0));
+  testFalse(set.has(2));
+  testTrue(set.has(5));
+
+  set.clear();
+
+  testEqual(set.size(), 0u);
+  testFalse(set.has(0));
+  testFalse(set.has(5));
+}
+
+UNITTEST(StaticFixedSet, Copy)
+{
+  StaticFixedSet<int, 64> set;
+  set.add(3);
+  set.add(63);
+
+  StaticFixedSet<int, 64> copy = set;
+  copy.remove(3);
+  copy.add(10);
+
+  testTrue(set.has(3));
+  testFalse(set.has(10));
+  testFalse(copy.has(3));
+  testTrue(copy.has(10));
+  testTrue(copy.has(63));
+}
+
+UNITTEST(StaticFixedSet, Iterator)
+{
+  std::vector<int> base{1, 5, 3, 6};
+  StaticFixedSet<int, 10> set;
+
+  for (int const & v : base) {
+    set.add(v);
+  }
+
+  for (int const v : set) {
+    testTrue(std::find(base.begin(), base.end(), v) != base.end());
+  }
+}
+
+
+}
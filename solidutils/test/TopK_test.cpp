@@ -0,0 +1,154 @@
+/**
+* @file TopK_test.cpp
+* @brief Unit tests for the TopK class.
+* @author Dominique LaSalle <dominique@solidlake.com>
+* Copyright 2019
+* @version 1
+* @date 2019-04-27
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+
+
+
+#include "UnitTest.hpp"
+#include "TopK.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+namespace sl
+{
+
+
+UNITTEST(TopK, AddDrain)
+{
+  TopK<int, int> top(3);
+
+  for (int i = 0; i < 10; ++i) {
+    top.add((i * 7) % 10, i);
+  }
+  testEqual(top.size(), 3u);
+  testEqual(top.capacity(), 3u);
+  testEqual(top.threshold(), 7);
+
+  std::vector<int> keys(3);
+  std::vector<int> values(3);
+  top.drain(keys.data(), values.data());
+
+  testEqual(top.size(), 0u);
+  testEqual(keys[0], 9);
+  testEqual(keys[1], 8);
+  testEqual(keys[2], 7);
+  for (int i = 0; i < 3; ++i) {
+    testEqual((values[i] * 7) % 10, keys[i]);
+  }
+}
+
+
+UNITTEST(TopK, Rejection)
+{
+  TopK<int, int> top(2);
+
+  testTrue(top.add(5, 0));
+  testTrue(top.add(3, 1));
+  testFalse(top.add(2, 2));
+  testFalse(top.add(3, 3));
+  testTrue(top.add(4, 4));
+  testEqual(top.threshold(), 4);
+}
+
+
+UNITTEST(TopK, Smallest)
+{
+  TopK<float, int, std::greater<float>> top(2);
+
+  for (int i = 0; i < 10; ++i) {
+    top.add(static_cast<float>(10 - i), i);
+  }
+
+  float keys[2];
+  int values[2];
+  top.drain(keys, values);
+  testEqual(keys[0], 1.0f);
+  testEqual(keys[1], 2.0f);
+  testEqual(values[0], 9);
+  testEqual(values[1], 8);
+}
+
+
+UNITTEST(TopK, AddManyRandom)
+{
+  size_t const num = 10000;
+  size_t const k = 37;
+
+  std::mt19937 rng(0);
+  std::vector<unsigned> keys(num);
+  std::vector<unsigned> values(num);
+  for (size_t i = 0; i < num; ++i) {
+    keys[i] = static_cast<unsigned>(rng() % 100000);
+    values[i] = static_cast<unsigned>(i);
+  }
+
+  TopK<unsigned, unsigned> top(k);
+  top.addMany(keys.data(), values.data(), num);
+  testEqual(top.size(), k);
+
+  std::vector<unsigned> topKeys(k);
+  std::vector<unsigned> topValues(k);
+  top.drain(topKeys.data(), topValues.data());
+
+  std::vector<unsigned> sorted(keys);
+  std::sort(sorted.begin(), sorted.end(), std::greater<unsigned>());
+  for (size_t i = 0; i < k; ++i) {
+    testEqual(topKeys[i], sorted[i]);
+    testEqual(keys[topValues[i]], topKeys[i]);
+  }
+}
+
+
+UNITTEST(TopK, FewerThanK)
+{
+  TopK<int, int> top(10);
+
+  int const keys[] = {4, 1, 3};
+  int const values[] = {0, 1, 2};
+  top.addMany(keys, values, 3);
+  testEqual(top.size(), 3u);
+
+  int outKeys[3];
+  int outValues[3];
+  top.drain(outKeys, outValues);
+  testEqual(outKeys[0], 4);
+  testEqual(outKeys[1], 3);
+  testEqual(outKeys[2], 1);
+
+  top.add(1, 1);
+  top.clear();
+  testEqual(top.size(), 0u);
+}
+
+
+}